@@ -0,0 +1,193 @@
+/* Copyright (C) 2009 - 2017 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S.
+Government.
+
+This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including,
+but not limited to, any warranty that the software will conform to, specifications any implied warranties of
+merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+documentation will conform to the program, or any warranty that the software will be error free.
+
+In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+consequential damages, arising out of, resulting from, or in any way connected with the software or its documentation.
+Whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained from, or arose
+out of the results of, or use of, the software, documentation or services provided hereunder
+
+ITC Team
+NASA IV&V
+ivv-itc@lists.nasa.gov
+*/
+
+/*******************************************************************************
+** File: cam_bench.c
+**
+** Purpose:
+**   Times the shared driver against the mock hwlib on a plain host.
+**
+** Usage:
+**   cam_bench_<sensor> [-n iterations] [-i image] [-v]
+**
+*******************************************************************************/
+
+/*************************************************************************
+** Includes
+*************************************************************************/
+#include "cam_device.h"
+
+#include <stdlib.h>
+#include <time.h>
+
+#ifndef CAM_BENCH_IMAGE
+#define CAM_BENCH_IMAGE "cam.bin"
+#endif
+
+#if defined(OV2640)
+#define CAM_BENCH_SENSOR "OV2640"
+#elif defined(OV5640)
+#define CAM_BENCH_SENSOR "OV5640"
+#else
+#define CAM_BENCH_SENSOR "OV5642"
+#endif
+
+/*************************************************************************
+** Private Data
+*************************************************************************/
+typedef int32_t (*Bench_Step_t)(uint8_t arg);
+
+static const char *Bench_Size_Names[] = {"160x120", "320x240", "800x600", "1600x1200", "2592x1944"};
+
+/*************************************************************************
+** Steps, each run once per iteration
+*************************************************************************/
+static int32_t bench_jpeg_init(uint8_t arg)
+{
+    return CAM_jpeg_init();
+}
+
+static int32_t bench_set_size(uint8_t size)
+{
+    return CAM_setSize(size);
+}
+
+static int32_t bench_picture_cold(uint8_t size)
+{
+    CAM_session_close();
+    return take_picture(size);
+}
+
+static int32_t bench_picture_warm(uint8_t size)
+{
+    return take_picture(size);
+}
+
+static double bench_now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1e6) + (ts.tv_nsec / 1e3);
+}
+
+/*
+** Runs step n times and prints per iteration wall time, bus traffic and the
+** delay the driver asked for, which the mock counts rather than sleeps
+*/
+static int32_t bench_run(const char *name, Bench_Step_t step, uint8_t arg, uint32_t n)
+{
+    Mock_Stats_t stats;
+    double       start;
+    double       wall;
+    uint32_t     i;
+    int32_t      result = OS_SUCCESS;
+
+    mock_reset_stats();
+    start = bench_now_us();
+    for (i = 0; (i < n) && (result == OS_SUCCESS); i++)
+    {
+        result = step(arg);
+    }
+    wall = (bench_now_us() - start) / n;
+    mock_stats(&stats);
+
+    printf("%-28s %10.1f %8u %8u %10llu %9.1f %10llu%s\n", name, wall, stats.i2c_calls / n, stats.spi_calls / n,
+           (unsigned long long)(stats.bytes / n), (wall > 0) ? ((double)stats.bytes / n) / wall : 0.0,
+           (unsigned long long)(stats.delay_ms / n), (result == OS_SUCCESS) ? "" : "  FAILED");
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *image = CAM_BENCH_IMAGE;
+    uint32_t    n     = 100;
+    int32_t     result;
+    char        name[32];
+    uint8_t     size;
+    int         arg;
+
+    for (arg = 1; arg < argc; arg++)
+    {
+        if ((strcmp(argv[arg], "-n") == 0) && (arg + 1 < argc))
+        {
+            n = strtoul(argv[++arg], NULL, 0);
+        }
+        else if ((strcmp(argv[arg], "-i") == 0) && (arg + 1 < argc))
+        {
+            image = argv[++arg];
+        }
+        else if (strcmp(argv[arg], "-v") == 0)
+        {
+            mock_set_verbose(true);
+        }
+        else
+        {
+            printf("usage: %s [-n iterations] [-i image] [-v]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (n == 0)
+    {
+        n = 1;
+    }
+
+    if (mock_load_image(image) != OS_SUCCESS)
+    {
+        printf("Unable to load FIFO image %s\n", image);
+        return EXIT_FAILURE;
+    }
+
+    printf("%s, %u iterations, %zu byte image\n", CAM_BENCH_SENSOR, n, mock_image_size());
+    printf("%-28s %10s %8s %8s %10s %9s %10s\n", "step", "wall_us", "i2c", "spi", "bytes", "MB/s", "delay_ms");
+
+    // Bring the session up once so the register steps have a bus to talk to
+    result = CAM_session_open(size_320x240);
+    if (result != OS_SUCCESS)
+    {
+        printf("CAM session open failed\n");
+        return EXIT_FAILURE;
+    }
+
+    result |= bench_run("CAM_jpeg_init", bench_jpeg_init, 0, n);
+    for (size = size_160x120; size <= size_2592x1944; size++)
+    {
+        snprintf(name, sizeof(name), "CAM_setSize %s", Bench_Size_Names[size]);
+        result |= bench_run(name, bench_set_size, size, n);
+    }
+    CAM_perf_reset();
+    for (size = size_160x120; size <= size_2592x1944; size++)
+    {
+        snprintf(name, sizeof(name), "take_picture cold %s", Bench_Size_Names[size]);
+        result |= bench_run(name, bench_picture_cold, size, n);
+        snprintf(name, sizeof(name), "take_picture warm %s", Bench_Size_Names[size]);
+        result |= bench_run(name, bench_picture_warm, size, n);
+    }
+
+    // Where the take_picture time went, the mock prints through OS_printf
+    printf("\ntake_picture stages\n");
+    mock_set_verbose(true);
+    CAM_perf_report();
+
+    CAM_session_close();
+    return (result == OS_SUCCESS) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/************************/
+/*  End of File Comment */
+/************************/
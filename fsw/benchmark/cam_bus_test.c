@@ -0,0 +1,233 @@
+/* Copyright (C) 2009 - 2017 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S.
+Government.
+
+This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including,
+but not limited to, any warranty that the software will conform to, specifications any implied warranties of
+merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+documentation will conform to the program, or any warranty that the software will be error free.
+
+In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+consequential damages, arising out of, resulting from, or in any way connected with the software or its documentation.
+Whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained from, or arose
+out of the results of, or use of, the software, documentation or services provided hereunder
+
+ITC Team
+NASA IV&V
+ivv-itc@lists.nasa.gov
+*/
+
+/*******************************************************************************
+** File: cam_bus_test.c
+**
+** Purpose:
+**   Bus trace round trip. Built with CAM_BUS_TRACE it runs the driver against
+**   the mock hwlib and records the trace, built with CAM_BUS_REPLAY it runs the
+**   same driver sequence from that trace and checks it matches the recording.
+**
+** Usage:
+**   cam_bus_record_<sensor> trace [-i image]
+**   cam_bus_replay_<sensor> trace
+**
+*******************************************************************************/
+
+/*************************************************************************
+** Includes
+*************************************************************************/
+#include "cam_device.h"
+
+#include <stdlib.h>
+
+#ifndef CAM_BENCH_IMAGE
+#define CAM_BENCH_IMAGE "cam.bin"
+#endif
+
+#if !defined(CAM_BUS_TRACE) && !defined(CAM_BUS_REPLAY)
+#error "Build with CAM_BUS_TRACE to record or CAM_BUS_REPLAY to replay"
+#endif
+
+#define BUS_TEST_FRAMES 2
+
+/*************************************************************************
+** Private Data
+*************************************************************************/
+/*
+** What the driver did, written next to the trace when recording and
+** compared against when replaying
+*/
+typedef struct
+{
+    uint32_t calls;
+    uint32_t bytes_out;
+    uint32_t bytes_in;
+    uint32_t frames;   /* Frames the burst sink saw end */
+    uint32_t checksum; /* FNV-1a over every byte given to the sink */
+} Bus_Test_Summary_t;
+
+static Bus_Test_Summary_t Bus_Test_Result;
+static char               Bus_Test_Buf[CAM_DATA_SIZE];
+
+/*************************************************************************
+** Helpers
+*************************************************************************/
+static int32_t bus_test_sink(uint8_t frame, char **buf, uint16_t length, uint8_t eoi)
+{
+    uint16_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        Bus_Test_Result.checksum = (Bus_Test_Result.checksum ^ (uint8_t)(*buf)[i]) * 16777619u;
+    }
+    if (eoi)
+    {
+        Bus_Test_Result.frames++;
+    }
+    return OS_SUCCESS;
+}
+
+/*
+** The same driver sequence for both builds: a single picture, then a burst
+*/
+static int32_t bus_test_run(void)
+{
+    CAM_Bus_Stats_t stats;
+    char           *buf = Bus_Test_Buf;
+    int32_t         result;
+
+    Bus_Test_Result.checksum = 2166136261u;
+    result = CAM_session_open(size_320x240);
+    if (result == OS_SUCCESS)
+    {
+        result = take_picture(size_320x240);
+    }
+    if (result == OS_SUCCESS)
+    {
+        result = CAM_capture_burst(BUS_TEST_FRAMES, &buf, sizeof(Bus_Test_Buf), bus_test_sink);
+    }
+    CAM_session_close();
+
+    CAM_bus_stats(&stats);
+    Bus_Test_Result.calls     = stats.calls;
+    Bus_Test_Result.bytes_out = stats.bytes_out;
+    Bus_Test_Result.bytes_in  = stats.bytes_in;
+    if (stats.mismatches != 0)
+    {
+        printf("%u calls differ from the trace\n", (unsigned)stats.mismatches);
+        result = OS_ERROR;
+    }
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef CAM_BUS_REPLAY
+    Bus_Test_Summary_t expected;
+    Mock_Stats_t       bus;
+#endif
+    const char        *image = CAM_BENCH_IMAGE;
+    const char        *trace = NULL;
+    char               summary[256];
+    FILE              *fp;
+    int32_t            result;
+    int                arg;
+
+    for (arg = 1; arg < argc; arg++)
+    {
+        if ((strcmp(argv[arg], "-i") == 0) && (arg + 1 < argc))
+        {
+            image = argv[++arg];
+        }
+        else if ((argv[arg][0] != '-') && (trace == NULL))
+        {
+            trace = argv[arg];
+        }
+        else
+        {
+            trace = NULL;
+            break;
+        }
+    }
+    if (trace == NULL)
+    {
+        printf("usage: %s trace [-i image]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    snprintf(summary, sizeof(summary), "%s.sum", trace);
+
+#ifdef CAM_BUS_TRACE
+    if (mock_load_image(image) != OS_SUCCESS)
+    {
+        printf("Unable to load FIFO image %s\n", image);
+        return EXIT_FAILURE;
+    }
+    if (CAM_bus_record(trace) != OS_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+    result = bus_test_run();
+    CAM_bus_stop();
+    if ((result == OS_SUCCESS) && (Bus_Test_Result.frames != BUS_TEST_FRAMES))
+    {
+        printf("Burst ended %u of %d frames\n", (unsigned)Bus_Test_Result.frames, BUS_TEST_FRAMES);
+        result = OS_ERROR;
+    }
+
+    fp = fopen(summary, "wb");
+    if ((fp == NULL) || (fwrite(&Bus_Test_Result, sizeof(Bus_Test_Result), 1, fp) != 1))
+    {
+        printf("Unable to write %s\n", summary);
+        result = OS_ERROR;
+    }
+    if (fp != NULL)
+    {
+        fclose(fp);
+    }
+    printf("Recorded %u calls, %u bytes out, %u bytes in to %s\n", (unsigned)Bus_Test_Result.calls,
+           (unsigned)Bus_Test_Result.bytes_out, (unsigned)Bus_Test_Result.bytes_in, trace);
+#else
+    (void)image;
+    fp = fopen(summary, "rb");
+    if ((fp == NULL) || (fread(&expected, sizeof(expected), 1, fp) != 1))
+    {
+        printf("Unable to read %s, record the trace first\n", summary);
+        if (fp != NULL)
+        {
+            fclose(fp);
+        }
+        return EXIT_FAILURE;
+    }
+    fclose(fp);
+
+    if (CAM_bus_replay(trace) != OS_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+    result = bus_test_run();
+    CAM_bus_stop();
+
+    // Nothing may have reached the mock bus, the trace served every call
+    mock_stats(&bus);
+    if ((bus.i2c_calls != 0) || (bus.spi_calls != 0))
+    {
+        printf("Replay reached the mock bus, %u i2c and %u spi calls\n", (unsigned)bus.i2c_calls,
+               (unsigned)bus.spi_calls);
+        result = OS_ERROR;
+    }
+    if (memcmp(&expected, &Bus_Test_Result, sizeof(expected)) != 0)
+    {
+        printf("Replay differs from the recording: calls %u/%u, bytes out %u/%u, bytes in %u/%u, frames %u/%u, "
+               "checksum %08x/%08x\n",
+               (unsigned)Bus_Test_Result.calls, (unsigned)expected.calls, (unsigned)Bus_Test_Result.bytes_out,
+               (unsigned)expected.bytes_out, (unsigned)Bus_Test_Result.bytes_in, (unsigned)expected.bytes_in,
+               (unsigned)Bus_Test_Result.frames, (unsigned)expected.frames, (unsigned)Bus_Test_Result.checksum,
+               (unsigned)expected.checksum);
+        result = OS_ERROR;
+    }
+    printf("Replayed %u calls from %s\n", (unsigned)Bus_Test_Result.calls, trace);
+#endif
+
+    return (result == OS_SUCCESS) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/************************/
+/*  End of File Comment */
+/************************/
@@ -0,0 +1,220 @@
+/* Copyright (C) 2009 - 2017 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S.
+Government.
+
+This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including,
+but not limited to, any warranty that the software will conform to, specifications any implied warranties of
+merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+documentation will conform to the program, or any warranty that the software will be error free.
+
+In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+consequential damages, arising out of, resulting from, or in any way connected with the software or its documentation.
+Whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained from, or arose
+out of the results of, or use of, the software, documentation or services provided hereunder
+
+ITC Team
+NASA IV&V
+ivv-itc@lists.nasa.gov
+*/
+
+/*******************************************************************************
+** File: cam_fifo_test.c
+**
+** Purpose:
+**   Reads a picture with CAM_read and a burst of frames out of the mock FIFO,
+**   which like the sim returns a stale byte first, and checks each one is the
+**   loaded JPEG through FF D9. With -e the FIFO holds exactly the JPEG, so the
+**   end of image is the last byte of the FIFO length.
+**
+** Usage:
+**   cam_fifo_test_<sensor> [-n frames] [-i image] [-e] [-v]
+**
+*******************************************************************************/
+
+/*************************************************************************
+** Includes
+*************************************************************************/
+#include "cam_device.h"
+
+#include <stdlib.h>
+
+#ifndef CAM_BENCH_IMAGE
+#define CAM_BENCH_IMAGE "cam.bin"
+#endif
+
+/*************************************************************************
+** Private Data
+*************************************************************************/
+static uint8_t *Fifo_Test_Image;  // JPEG as loaded, through its end of image
+static uint32_t Fifo_Test_Length;
+static uint8_t *Fifo_Test_Frame;  // Frame put back together from the sink
+static uint32_t Fifo_Test_Fill;
+static uint32_t Fifo_Test_Good;
+static char     Fifo_Test_Buf[CAM_DATA_SIZE];
+
+/*************************************************************************
+** Helpers
+*************************************************************************/
+static int32_t fifo_test_load(const char *path, bool exact)
+{
+    FILE *fp = fopen(path, "rb");
+    long  size;
+
+    if (fp == NULL)
+    {
+        return OS_ERROR;
+    }
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    Fifo_Test_Image = malloc(size);
+    Fifo_Test_Frame = malloc(size);
+    if ((Fifo_Test_Image == NULL) || (Fifo_Test_Frame == NULL) ||
+        (fread(Fifo_Test_Image, 1, size, fp) != (size_t)size))
+    {
+        fclose(fp);
+        return OS_ERROR;
+    }
+    fclose(fp);
+
+    // Anything after the end of image is padding the drain must not hand on
+    Fifo_Test_Length = CAM_jpeg_find_marker(0x00, Fifo_Test_Image, size, CAM_JPEG_EOI);
+    if (Fifo_Test_Length == 0)
+    {
+        return OS_ERROR;
+    }
+    return mock_set_image(Fifo_Test_Image, exact ? Fifo_Test_Length : (size_t)size);
+}
+
+static int32_t fifo_test_sink(uint8_t frame, char **buf, uint16_t length, uint8_t eoi)
+{
+    if ((Fifo_Test_Fill + length) > Fifo_Test_Length)
+    {
+        printf("Frame %u runs past %u bytes\n", (unsigned)frame, (unsigned)Fifo_Test_Length);
+        return OS_ERROR;
+    }
+    memcpy(&Fifo_Test_Frame[Fifo_Test_Fill], *buf, length);
+    Fifo_Test_Fill += length;
+    if (!eoi)
+    {
+        return OS_SUCCESS;
+    }
+
+    if ((Fifo_Test_Fill < 4) || (Fifo_Test_Frame[Fifo_Test_Fill - 2] != 0xFF) ||
+        (Fifo_Test_Frame[Fifo_Test_Fill - 1] != 0xD9))
+    {
+        printf("Frame %u does not end in FF D9\n", (unsigned)frame);
+    }
+    else if ((Fifo_Test_Fill != Fifo_Test_Length) || (memcmp(Fifo_Test_Frame, Fifo_Test_Image, Fifo_Test_Length) != 0))
+    {
+        printf("Frame %u is %u bytes, not the %u byte image\n", (unsigned)frame, (unsigned)Fifo_Test_Fill,
+               (unsigned)Fifo_Test_Length);
+    }
+    else
+    {
+        Fifo_Test_Good++;
+    }
+    Fifo_Test_Fill = 0;
+    return OS_SUCCESS;
+}
+
+/*
+** One picture read the way take_picture does, a packet at a time
+*/
+static int32_t fifo_test_picture(void)
+{
+    char    *buf    = Fifo_Test_Buf;
+    uint8_t  status = 1;
+    uint16_t x      = 0;
+    uint32_t length;
+    int32_t  result;
+
+    result = CAM_capture_prep();
+    if (result == OS_SUCCESS)
+    {
+        result = CAM_capture();
+    }
+    if (result == OS_SUCCESS)
+    {
+        result = CAM_read_fifo_length(&length);
+    }
+    if (result == OS_SUCCESS)
+    {
+        result = CAM_read_prep(Fifo_Test_Buf, &x);
+    }
+    while ((result == OS_SUCCESS) && (status > 0) && (status <= 8))
+    {
+        result = CAM_read(Fifo_Test_Buf, &x, sizeof(Fifo_Test_Buf), &status);
+        if (result == OS_SUCCESS)
+        {
+            result = fifo_test_sink(0, &buf, x, (status == OS_SUCCESS));
+        }
+        x = 0;
+    }
+    return (status == OS_SUCCESS) ? result : OS_ERROR;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *image  = CAM_BENCH_IMAGE;
+    uint32_t    frames = 10;
+    bool        exact  = false;
+    char       *buf    = Fifo_Test_Buf;
+    int32_t     result;
+    int         arg;
+
+    for (arg = 1; arg < argc; arg++)
+    {
+        if ((strcmp(argv[arg], "-n") == 0) && (arg + 1 < argc))
+        {
+            frames = strtoul(argv[++arg], NULL, 0);
+        }
+        else if ((strcmp(argv[arg], "-i") == 0) && (arg + 1 < argc))
+        {
+            image = argv[++arg];
+        }
+        else if (strcmp(argv[arg], "-e") == 0)
+        {
+            exact = true;
+        }
+        else if (strcmp(argv[arg], "-v") == 0)
+        {
+            mock_set_verbose(true);
+        }
+        else
+        {
+            printf("usage: %s [-n frames] [-i image] [-e] [-v]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if ((frames == 0) || (frames > CAM_BURST_MAX_FRAMES))
+    {
+        frames = CAM_BURST_MAX_FRAMES;
+    }
+
+    if (fifo_test_load(image, exact) != OS_SUCCESS)
+    {
+        printf("Unable to load a JPEG from %s\n", image);
+        return EXIT_FAILURE;
+    }
+
+    result = CAM_session_open(size_320x240);
+    if (result == OS_SUCCESS)
+    {
+        result = fifo_test_picture();
+    }
+    if (result == OS_SUCCESS)
+    {
+        result = CAM_capture_burst(frames, &buf, sizeof(Fifo_Test_Buf), fifo_test_sink);
+    }
+    CAM_session_close();
+
+    // The picture, then every frame of the burst
+    printf("%u of %u frames drained intact, %u byte image%s\n", (unsigned)Fifo_Test_Good, (unsigned)(frames + 1),
+           (unsigned)Fifo_Test_Length, exact ? " filling the FIFO" : "");
+    return ((result == OS_SUCCESS) && (Fifo_Test_Good == (frames + 1))) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/************************/
+/*  End of File Comment */
+/************************/
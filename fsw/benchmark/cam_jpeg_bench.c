@@ -0,0 +1,270 @@
+/* Copyright (C) 2009 - 2017 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S.
+Government.
+
+This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including,
+but not limited to, any warranty that the software will conform to, specifications any implied warranties of
+merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+documentation will conform to the program, or any warranty that the software will be error free.
+
+In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+consequential damages, arising out of, resulting from, or in any way connected with the software or its documentation.
+Whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained from, or arose
+out of the results of, or use of, the software, documentation or services provided hereunder
+
+ITC Team
+NASA IV&V
+ivv-itc@lists.nasa.gov
+*/
+
+/*******************************************************************************
+** File: cam_jpeg_bench.c
+**
+** Purpose:
+**   Times locating the JPEG markers of a frame in RAM, the byte at a time
+**   marker switch CAM_read used to run against CAM_jpeg_find_marker and
+**   CAM_jpeg_index. Also checks CAM_jpeg_index on small malformed frames.
+**
+** Usage:
+**   cam_jpeg_bench [-n iterations] [-i image]
+**
+*******************************************************************************/
+
+/*************************************************************************
+** Includes
+*************************************************************************/
+#include "cam_jpeg.h"
+
+#include <stdlib.h>
+#include <time.h>
+
+#ifndef CAM_BENCH_IMAGE
+#define CAM_BENCH_IMAGE "cam.bin"
+#endif
+
+/*************************************************************************
+** Private Data
+*************************************************************************/
+static volatile uint32_t Bench_Sink; // Keeps results from being optimized out
+
+/*
+** Frames CAM_jpeg_index has to judge without reading past their end
+*/
+typedef struct
+{
+    const char   *name;
+    const uint8_t data[16];
+    uint32_t      length;
+    int32_t       result;
+} Bench_Frame_t;
+
+static const Bench_Frame_t Bench_Frames[] = {
+    {"minimal", {0xFF, 0xD8, 0xFF, 0xDA, 0x00, 0x02, 0x11, 0x22, 0xFF, 0xD9}, 10, OS_SUCCESS},
+    {"truncated SOS segment", {0xFF, 0xD8, 0xFF, 0xDA, 0x40, 0x00, 0x11, 0x22}, 8, OS_ERROR},
+    {"truncated DQT segment", {0xFF, 0xD8, 0xFF, 0xDB, 0x00, 0x43, 0x00}, 7, OS_ERROR},
+    {"SOS segment ends the frame", {0xFF, 0xD8, 0xFF, 0xDA, 0x00, 0x04, 0x11, 0x22}, 8, OS_ERROR},
+    {"no end of image", {0xFF, 0xD8, 0xFF, 0xDA, 0x00, 0x02, 0x11, 0x22, 0x33}, 9, OS_ERROR},
+};
+
+/*
+** The per byte marker tracking CAM_read did before the length driven drain
+*/
+static uint32_t bench_byte_loop(const uint8_t *data, uint32_t length)
+{
+    uint8_t  last   = 0x00;
+    uint8_t  status = 1;
+    uint32_t n;
+
+    for (n = 0; n < length; n++)
+    {
+        if (last == 0xFF)
+        {
+            switch (data[n])
+            {
+                case 0xD8:
+                case 0xDA:
+                case 0xDB:
+                case 0xC4:
+                case 0xD3:
+                    status++;
+                    break;
+                case 0xD9:
+                    Bench_Sink = status;
+                    return n + 1;
+                default:
+                    break;
+            }
+        }
+        last = data[n];
+    }
+    return 0;
+}
+
+static uint32_t bench_find_marker(const uint8_t *data, uint32_t length)
+{
+    return CAM_jpeg_find_marker(0x00, data, length, CAM_JPEG_EOI);
+}
+
+static uint32_t bench_index(const uint8_t *data, uint32_t length)
+{
+    static CAM_Jpeg_Index_t index;
+
+    CAM_jpeg_index(data, length, &index);
+    Bench_Sink = index.count;
+    return index.length;
+}
+
+/*
+** Each frame is copied to a buffer of exactly its length so a sanitizer sees any overread
+*/
+static int bench_frames(void)
+{
+    CAM_Jpeg_Index_t index;
+    uint8_t         *data;
+    int32_t          status;
+    uint32_t         i;
+    int              result = EXIT_SUCCESS;
+
+    printf("\n%-28s %8s %8s\n", "frame", "expect", "result");
+    for (i = 0; i < (sizeof(Bench_Frames) / sizeof(Bench_Frames[0])); i++)
+    {
+        data = malloc(Bench_Frames[i].length);
+        if (data == NULL)
+        {
+            return EXIT_FAILURE;
+        }
+        memcpy(data, Bench_Frames[i].data, Bench_Frames[i].length);
+        status = CAM_jpeg_index(data, Bench_Frames[i].length, &index);
+        free(data);
+
+        printf("%-28s %8d %8d%s\n", Bench_Frames[i].name, (int)Bench_Frames[i].result, (int)status,
+               (status == Bench_Frames[i].result) ? "" : "  FAILED");
+        if (status != Bench_Frames[i].result)
+        {
+            result = EXIT_FAILURE;
+        }
+    }
+    return result;
+}
+
+static double bench_now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1e6) + (ts.tv_nsec / 1e3);
+}
+
+/*
+** Runs scan n times, prints per frame time and rate, returns the end of image it found
+*/
+static uint32_t bench_run(const char *name, uint32_t (*scan)(const uint8_t *, uint32_t), const uint8_t *data,
+                          uint32_t length, uint32_t n)
+{
+    double   start;
+    double   wall;
+    uint32_t end = 0;
+    uint32_t i;
+
+    start = bench_now_us();
+    for (i = 0; i < n; i++)
+    {
+        end = scan(data, length);
+    }
+    wall = (bench_now_us() - start) / n;
+
+    printf("%-24s %10.2f %10.1f %10u\n", name, wall, (wall > 0) ? length / wall : 0.0, end);
+    return end;
+}
+
+int main(int argc, char *argv[])
+{
+    const char      *image = CAM_BENCH_IMAGE;
+    uint32_t         n     = 1000;
+    CAM_Jpeg_Index_t index;
+    uint8_t         *data;
+    FILE            *fp;
+    long             length;
+    uint32_t         eoi;
+    uint32_t         i;
+    int              arg;
+    int              result = EXIT_SUCCESS;
+
+    for (arg = 1; arg < argc; arg++)
+    {
+        if ((strcmp(argv[arg], "-n") == 0) && (arg + 1 < argc))
+        {
+            n = strtoul(argv[++arg], NULL, 0);
+        }
+        else if ((strcmp(argv[arg], "-i") == 0) && (arg + 1 < argc))
+        {
+            image = argv[++arg];
+        }
+        else
+        {
+            printf("usage: %s [-n iterations] [-i image]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (n == 0)
+    {
+        n = 1;
+    }
+
+    fp = fopen(image, "rb");
+    if (fp == NULL)
+    {
+        printf("Unable to open %s\n", image);
+        return EXIT_FAILURE;
+    }
+    fseek(fp, 0, SEEK_END);
+    length = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    data = malloc(length);
+    if ((data == NULL) || (fread(data, 1, length, fp) != (size_t)length))
+    {
+        printf("Unable to read %s\n", image);
+        fclose(fp);
+        free(data);
+        return EXIT_FAILURE;
+    }
+    fclose(fp);
+
+    // All three have to agree on where the image ends
+    printf("%ld byte frame, %u iterations\n", length, n);
+    printf("%-24s %10s %10s %10s\n", "scan", "us", "MB/s", "eoi_end");
+    eoi = bench_run("byte loop", bench_byte_loop, data, length, n);
+    if (bench_run("CAM_jpeg_find_marker", bench_find_marker, data, length, n) != eoi)
+    {
+        result = EXIT_FAILURE;
+    }
+    if (bench_run("CAM_jpeg_index", bench_index, data, length, n) != eoi)
+    {
+        result = EXIT_FAILURE;
+    }
+
+    if (CAM_jpeg_index(data, length, &index) != OS_SUCCESS)
+    {
+        printf("\nNot a complete JPEG\n");
+        result = EXIT_FAILURE;
+    }
+    else
+    {
+        printf("\n%u markers, %u restarts every %u MCUs, scan at %u, %ld trailing bytes\n", index.count,
+               index.restarts, index.restart_interval, index.scan, length - index.length);
+        for (i = 0; i < index.count; i++)
+        {
+            printf("  0x%06x FF%02X\n", index.markers[i].offset, index.markers[i].marker);
+        }
+    }
+
+    free(data);
+    if (bench_frames() != EXIT_SUCCESS)
+    {
+        result = EXIT_FAILURE;
+    }
+    return (result == EXIT_SUCCESS) ? ((eoi > 0) ? EXIT_SUCCESS : EXIT_FAILURE) : EXIT_FAILURE;
+}
+
+/************************/
+/*  End of File Comment */
+/************************/
@@ -0,0 +1,94 @@
+/* Copyright (C) 2009 - 2017 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S.
+Government.
+
+This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including,
+but not limited to, any warranty that the software will conform to, specifications any implied warranties of
+merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+documentation will conform to the program, or any warranty that the software will be error free.
+
+In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+consequential damages, arising out of, resulting from, or in any way connected with the software or its documentation.
+Whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained from, or arose
+out of the results of, or use of, the software, documentation or services provided hereunder
+
+ITC Team
+NASA IV&V
+ivv-itc@lists.nasa.gov
+*/
+
+/*
+** In-process stand in for hwlib so the shared driver runs on a plain host.
+** Only what cam_device.c and cam_registers.c use is declared, see mock_hwlib.c.
+*/
+#ifndef _benchmark_hwlib_h_
+#define _benchmark_hwlib_h_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define OS_SUCCESS  0
+#define OS_ERROR    (-1)
+#define PORT_CLOSED 0
+#define PORT_OPEN   1
+
+typedef int32_t  int32;
+typedef uint32_t uint32;
+typedef int16_t  int16;
+typedef uint16_t uint16;
+typedef uint8_t  uint8;
+
+typedef struct
+{
+    int      handle;
+    uint8_t  isOpen;
+    uint8_t  addr;
+    uint32_t speed;
+} i2c_bus_info_t;
+
+typedef struct
+{
+    int      handle;
+    char    *deviceString;
+    uint32_t baudrate;
+    uint8_t  spi_mode;
+    uint8_t  bitsPerWord;
+    uint8_t  cs;
+    uint8_t  bus;
+    uint8_t  isOpen;
+} spi_info_t;
+
+/*
+** Bus and delay totals since the last reset
+*/
+typedef struct
+{
+    uint32_t i2c_calls;
+    uint32_t spi_calls;
+    uint64_t bytes;    /* Written and read on both buses */
+    uint64_t delay_ms; /* Asked for through OS_TaskDelay, not slept */
+} Mock_Stats_t;
+
+int32_t OS_TaskDelay(uint32_t ms);
+void    OS_printf(const char *format, ...);
+
+int32_t i2c_master_init(i2c_bus_info_t *device);
+int32_t i2c_master_close(i2c_bus_info_t *device);
+int32_t i2c_master_transaction(i2c_bus_info_t *device, uint8_t addr, void *txbuf, uint8_t txlen, void *rxbuf,
+                               uint8_t rxlen, uint16_t timeout);
+int32_t spi_init_dev(spi_info_t *device);
+int32_t spi_select_chip(spi_info_t *device);
+int32_t spi_unselect_chip(spi_info_t *device);
+int32_t spi_write(spi_info_t *device, uint8_t data[], const uint32_t numBytes);
+int32_t spi_read(spi_info_t *device, uint8_t data[], const uint32_t numBytes);
+int32_t spi_close_device(spi_info_t *device);
+
+int32_t mock_load_image(const char *path);
+int32_t mock_set_image(const uint8_t *data, size_t size);
+size_t  mock_image_size(void);
+void    mock_stats(Mock_Stats_t *stats);
+void    mock_reset_stats(void);
+void    mock_set_verbose(bool verbose);
+
+#endif /* _benchmark_hwlib_h_ */
@@ -0,0 +1,321 @@
+/* Copyright (C) 2009 - 2017 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S.
+Government.
+
+This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including,
+but not limited to, any warranty that the software will conform to, specifications any implied warranties of
+merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+documentation will conform to the program, or any warranty that the software will be error free.
+
+In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+consequential damages, arising out of, resulting from, or in any way connected with the software or its documentation.
+Whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained from, or arose
+out of the results of, or use of, the software, documentation or services provided hereunder
+
+ITC Team
+NASA IV&V
+ivv-itc@lists.nasa.gov
+*/
+
+/*******************************************************************************
+** File: mock_hwlib.c
+**
+** Purpose:
+**   ArduChip and sensor behavior the driver depends on, served in process.
+**   Captures complete at once and the FIFO holds a JPEG loaded from a file.
+**
+*******************************************************************************/
+
+/*************************************************************************
+** Includes
+*************************************************************************/
+#include "device_cfg.h"
+#include "hwlib.h"
+
+#include <stdarg.h>
+#include <stdlib.h>
+
+/*************************************************************************
+** Private Data
+*************************************************************************/
+static uint8_t     *Mock_Image;
+static size_t       Mock_Image_Size;
+static size_t       Mock_Pos;         // Next FIFO byte
+static uint8_t      Mock_Frames_Left; // Frames still to clock out of the FIFO
+static uint8_t      Mock_Fifo_Byte;   // Byte the next FIFO read returns, stale right after a capture
+static uint8_t      Mock_Reg[0x80];   // ArduChip registers
+static uint8_t      Mock_Response;    // Register value for the read after a write
+static bool         Mock_Burst;
+static bool         Mock_Done;
+static uint32_t     Mock_Length;
+static bool         Mock_Verbose;
+static Mock_Stats_t Mock_Stats;
+
+static void mock_fifo_next(void)
+{
+    if ((Mock_Pos >= Mock_Image_Size) && (Mock_Frames_Left > 1))
+    {
+        Mock_Frames_Left--;
+        Mock_Pos = 0;
+    }
+    if (Mock_Pos < Mock_Image_Size)
+    {
+        Mock_Fifo_Byte = Mock_Image[Mock_Pos++];
+    }
+}
+
+/*******************************************************************************
+** OSAL
+*******************************************************************************/
+int32_t OS_TaskDelay(uint32_t ms)
+{
+    Mock_Stats.delay_ms += ms;
+    return OS_SUCCESS;
+}
+
+void OS_printf(const char *format, ...)
+{
+    va_list args;
+
+    if (Mock_Verbose)
+    {
+        va_start(args, format);
+        vprintf(format, args);
+        va_end(args);
+    }
+}
+
+/*******************************************************************************
+** I2C
+*******************************************************************************/
+int32_t i2c_master_init(i2c_bus_info_t *device)
+{
+    device->isOpen = PORT_OPEN;
+    return OS_SUCCESS;
+}
+
+int32_t i2c_master_close(i2c_bus_info_t *device)
+{
+    device->isOpen = PORT_CLOSED;
+    return OS_SUCCESS;
+}
+
+int32_t i2c_master_transaction(i2c_bus_info_t *device, uint8_t addr, void *txbuf, uint8_t txlen, void *rxbuf,
+                               uint8_t rxlen, uint16_t timeout)
+{
+    const uint8_t *tx  = txbuf;
+    uint16_t       reg = 0;
+
+    Mock_Stats.i2c_calls++;
+    Mock_Stats.bytes += txlen + rxlen;
+    if ((rxlen == 0) || (txlen == 0))
+    {
+        return OS_SUCCESS;
+    }
+
+    // Only the chip ID is read back, every other register reads 0
+    memset(rxbuf, 0, rxlen);
+#ifdef OV2640
+    reg = tx[0];
+    if (reg == 0x0A)
+    {
+        *(uint8_t *)rxbuf = 0x26;
+    }
+    if (reg == 0x0B)
+    {
+        *(uint8_t *)rxbuf = 0x42;
+    }
+#else
+    reg = (txlen > 1) ? ((tx[0] << 8) | tx[1]) : tx[0];
+    if (reg == 0x300A)
+    {
+        *(uint8_t *)rxbuf = 0x56;
+    }
+    if (reg == 0x300B)
+    {
+#ifdef OV5642
+        *(uint8_t *)rxbuf = 0x42;
+#else
+        *(uint8_t *)rxbuf = 0x40;
+#endif
+    }
+#endif
+    return OS_SUCCESS;
+}
+
+/*******************************************************************************
+** SPI
+*******************************************************************************/
+int32_t spi_init_dev(spi_info_t *device)
+{
+    device->isOpen = PORT_OPEN;
+    return OS_SUCCESS;
+}
+
+int32_t spi_close_device(spi_info_t *device)
+{
+    device->isOpen = PORT_CLOSED;
+    return OS_SUCCESS;
+}
+
+int32_t spi_select_chip(spi_info_t *device)
+{
+    return OS_SUCCESS;
+}
+
+int32_t spi_unselect_chip(spi_info_t *device)
+{
+    Mock_Burst = false;
+    return OS_SUCCESS;
+}
+
+int32_t spi_write(spi_info_t *device, uint8_t data[], const uint32_t numBytes)
+{
+    uint8_t reg = data[0] & 0x7F;
+
+    Mock_Stats.spi_calls++;
+    Mock_Stats.bytes += numBytes;
+    Mock_Burst    = false;
+    Mock_Response = 0x00;
+
+    switch (reg)
+    {
+        case 0x3C: // Burst FIFO read
+            Mock_Burst = true;
+            return OS_SUCCESS;
+        case 0x3D: // Single FIFO read, with or without the write bit
+            Mock_Response = Mock_Fifo_Byte;
+            mock_fifo_next();
+            return OS_SUCCESS;
+        default:
+            break;
+    }
+
+    if ((data[0] & 0x80) && (numBytes > 1))
+    {
+        Mock_Reg[reg] = data[1];
+        if (reg == 0x04)
+        {
+            if (data[1] & 0x01)
+            {
+                Mock_Done = false;
+            }
+            if (data[1] & 0x02)
+            {
+                // Capture is done as soon as it starts, like the sim nothing is fetched yet
+                // so the first FIFO read returns whatever byte was left from before
+                Mock_Frames_Left = (Mock_Reg[0x01] & 0x07) + 1;
+                Mock_Pos         = 0;
+                Mock_Length      = (uint32_t)(Mock_Image_Size * Mock_Frames_Left) & 0x7FFFFF;
+                Mock_Done        = true;
+            }
+        }
+        return OS_SUCCESS;
+    }
+
+    switch (reg)
+    {
+        case 0x41:
+            Mock_Response = Mock_Done ? CAP_DONE_MASK : 0x00;
+            break;
+        case 0x42:
+            Mock_Response = Mock_Length & 0xFF;
+            break;
+        case 0x43:
+            Mock_Response = (Mock_Length >> 8) & 0xFF;
+            break;
+        case 0x44:
+            Mock_Response = (Mock_Length >> 16) & 0x7F;
+            break;
+        default:
+            Mock_Response = Mock_Reg[reg];
+            break;
+    }
+    return OS_SUCCESS;
+}
+
+int32_t spi_read(spi_info_t *device, uint8_t data[], const uint32_t numBytes)
+{
+    uint32_t i;
+
+    Mock_Stats.spi_calls++;
+    Mock_Stats.bytes += numBytes;
+    if (Mock_Burst)
+    {
+        for (i = 0; i < numBytes; i++)
+        {
+            data[i] = Mock_Fifo_Byte;
+            mock_fifo_next();
+        }
+    }
+    else if (numBytes > 0)
+    {
+        // Register value comes back in the second byte
+        memset(data, 0, numBytes);
+        data[numBytes - 1] = Mock_Response;
+    }
+    return OS_SUCCESS;
+}
+
+/*******************************************************************************
+** Benchmark Control
+*******************************************************************************/
+int32_t mock_load_image(const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    long  size;
+
+    if (fp == NULL)
+    {
+        return OS_ERROR;
+    }
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    free(Mock_Image);
+    Mock_Image      = malloc(size);
+    Mock_Image_Size = 0;
+    if ((Mock_Image != NULL) && (fread(Mock_Image, 1, size, fp) == (size_t)size))
+    {
+        Mock_Image_Size = size;
+    }
+    fclose(fp);
+    return (Mock_Image_Size > 0) ? OS_SUCCESS : OS_ERROR;
+}
+
+int32_t mock_set_image(const uint8_t *data, size_t size)
+{
+    free(Mock_Image);
+    Mock_Image      = malloc(size);
+    Mock_Image_Size = 0;
+    if ((Mock_Image != NULL) && (size > 0))
+    {
+        memcpy(Mock_Image, data, size);
+        Mock_Image_Size = size;
+    }
+    return (Mock_Image_Size > 0) ? OS_SUCCESS : OS_ERROR;
+}
+
+size_t mock_image_size(void)
+{
+    return Mock_Image_Size;
+}
+
+void mock_stats(Mock_Stats_t *stats)
+{
+    *stats = Mock_Stats;
+}
+
+void mock_reset_stats(void)
+{
+    memset(&Mock_Stats, 0, sizeof(Mock_Stats));
+}
+
+void mock_set_verbose(bool verbose)
+{
+    Mock_Verbose = verbose;
+}
+
+/************************/
+/*  End of File Comment */
+/************************/
@@ -37,12 +37,34 @@ ivv-itc@lists.nasa.gov
 #define CAM_SPEED                 1000000
 #define CAP_DONE_MASK             0x08
 #define CAM_TIMEOUT               100
-#define CAM_DATA_SIZE             1010
+#define CAM_DATA_SIZE             1010 // Max image bytes per experiment packet
+#define CAM_BURST_CHUNK_SIZE      256 // Bytes per burst FIFO read, 0 for single byte reads
+#define CAM_I2C_BURST_SIZE        32 // Max sequential register values per I2C write, 1 disables batching
+#define CAM_I2C_YIELD_EVERY       16 // I2C register writes between task yields, 0 never yields
+#define CAM_I2C_YIELD_DELAY       1 // Task delay in ms for each I2C yield
+#define CAM_POLL_SPINS            4 // Status reads without delay before backing off
+#define CAM_POLL_DELAY_MIN        1 // First back-off delay in ms, doubled each poll
+#define CAM_POLL_DELAY_MAX        64 // Back-off delay cap in ms
+#define CAM_POLL_DEADLINE         500 // Max wait in ms for a handshake to complete
+#define CAM_CAPTURE_DEADLINE      10000 // Max wait in ms for the capture done flag
+#define CAM_RESET_SETTLE          10 // Min ms after a sensor reset before it is polled or programmed
+#define CAM_BURST_MAX_FRAMES      32 // Max frames a single burst command may request
+#define CAM_JPEG_MAX_MARKERS      64 // Segment and restart markers kept in a frame index
+#define CAM_RATE_BYTES_PER_SEC    4096 // Default experiment downlink rate, 0 is unthrottled
+#define CAM_RATE_BURST_BYTES      4096 // Default bytes that may be sent back to back
 #define CAM_CHILD_TASK_NAME       "CAM_CHILD_TASK"
 #define CAM_CHILD_TASK_STACK_SIZE 2048
 #define CAM_CHILD_TASK_PRIORITY   205
 #define CAM_MUTEX_NAME            "CAM_MUTEX"
 #define CAM_SEM_NAME              "CAM_SEM"
+#define CAM_DOWNLINK_TASK_NAME    "CAM_DOWNLINK_TASK"
+#define CAM_DOWNLINK_STACK_SIZE   2048
+#define CAM_DOWNLINK_PRIORITY     206
+#define CAM_IMAGE_SLOTS           2 // Whole images staged between capture and downlink
+#define CAM_IMAGE_SLOT_SIZE       (1024 * 1024) // Bytes per staged image, bounds the largest JPEG
+#define CAM_IMAGE_MEM_BUDGET      (2 * 1024 * 1024) // Static RAM the staged images may take
+#define CAM_IMAGE_QUEUE_NAME      "CAM_IMAGE_Q"
+#define CAM_FREE_QUEUE_NAME       "CAM_FREE_Q"
 // Select Hardware (only 1)
 //#define OV2640
 #define OV5640
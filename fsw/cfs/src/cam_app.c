@@ -31,6 +31,19 @@ ivv-itc@lists.nasa.gov
 */
 CAM_AppData_t CAM_AppData;
 
+/*
+** CAM_DataLock() / CAM_DataUnlock() -- data mutex around driver state housekeeping reads
+*/
+static void CAM_DataLock(void)
+{
+    OS_MutSemTake(CAM_AppData.data_mutex);
+}
+
+static void CAM_DataUnlock(void)
+{
+    OS_MutSemGive(CAM_AppData.data_mutex);
+}
+
 /*
 ** arducam_AppMain() -- Application entry point and main process loop
 */
@@ -160,6 +173,9 @@ int32 CAM_AppInit(void)
             break;
         }
 
+        /* Polling waits are written by the child task and reported from this one */
+        CAM_wait_lock(CAM_DataLock, CAM_DataUnlock);
+
         /*
         ** Create child task wakeup semaphore
         */
@@ -177,6 +193,10 @@ int32 CAM_AppInit(void)
         CAM_AppData.State                            = CAM_STOP;
         CAM_AppData.Exp                              = 0;
         CAM_AppData.Size                             = size_160x120;
+        CAM_AppData.Frames                           = 1;
+        CAM_AppData.DataSize                         = CAM_DATA_SIZE;
+        CAM_AppData.DebugPkt                         = NULL;
+        CAM_rate_set(CAM_RATE_BYTES_PER_SEC, CAM_RATE_BURST_BYTES);
         CAM_AppData.HkTelemetryPkt.CommandCount      = 0;
         CAM_AppData.HkTelemetryPkt.CommandErrorCount = 0;
 
@@ -197,9 +217,6 @@ int32 CAM_AppInit(void)
         CFE_MSG_Init(CFE_MSG_PTR(CAM_AppData.HkTelemetryPkt.TlmHeader), CFE_SB_ValueToMsgId(CAM_HK_TLM_MID),
                      CAM_HK_TLM_LNGTH);
 
-        CFE_MSG_Init(CFE_MSG_PTR(CAM_AppData.Exp_Pkt.TlmHeader), CFE_SB_ValueToMsgId(CAM_EXP_TLM_MID),
-                     CAM_EXP_TLM_LNGTH);
-
         /*
         ** Important to send an information event that the app has initialized. this is
         ** useful for debugging the loading of individual apps
@@ -360,7 +377,8 @@ void CAM_ProcessGroundCommand(void)
         case CAM_LOW_VOLTAGE_CC:
             OS_MutSemTake(CAM_AppData.data_mutex);
             CAM_AppData.HkTelemetryPkt.CommandCount++;
-            CAM_AppData.State = CAM_LOW_VOLTAGE;
+            CAM_AppData.State  = CAM_LOW_VOLTAGE;
+            CAM_AppData.Reinit = 1;
             OS_MutSemGive(CAM_AppData.data_mutex);
             CFE_EVS_SendEvent(CAM_LOW_VOLTAGE_INT_EID, CFE_EVS_EventType_INFORMATION, "CAM App: LOW_VOLTAGE command");
             break;
@@ -371,7 +389,8 @@ void CAM_ProcessGroundCommand(void)
         case CAM_EXP1_CC:
             OS_MutSemTake(CAM_AppData.data_mutex);
             CAM_AppData.HkTelemetryPkt.CommandCount++;
-            CAM_AppData.Exp = 1;
+            CAM_AppData.Exp    = 1;
+            CAM_AppData.Frames = 1;
             OS_MutSemGive(CAM_AppData.data_mutex);
             CFE_EVS_SendEvent(CAM_EXP1_EID, CFE_EVS_EventType_INFORMATION, "CAM App: EXP 1 Command - Small Picture");
             OS_BinSemGive(CAM_AppData.sem_id);
@@ -383,7 +402,8 @@ void CAM_ProcessGroundCommand(void)
         case CAM_EXP2_CC:
             OS_MutSemTake(CAM_AppData.data_mutex);
             CAM_AppData.HkTelemetryPkt.CommandCount++;
-            CAM_AppData.Exp = 2;
+            CAM_AppData.Exp    = 2;
+            CAM_AppData.Frames = 1;
             OS_MutSemGive(CAM_AppData.data_mutex);
             CFE_EVS_SendEvent(CAM_EXP2_EID, CFE_EVS_EventType_INFORMATION, "CAM App: EXP 2 Command - Medium Picture");
             OS_BinSemGive(CAM_AppData.sem_id);
@@ -394,12 +414,106 @@ void CAM_ProcessGroundCommand(void)
         case CAM_EXP3_CC:
             OS_MutSemTake(CAM_AppData.data_mutex);
             CAM_AppData.HkTelemetryPkt.CommandCount++;
-            CAM_AppData.Exp = 3;
+            CAM_AppData.Exp    = 3;
+            CAM_AppData.Frames = 1;
             OS_MutSemGive(CAM_AppData.data_mutex);
             CFE_EVS_SendEvent(CAM_EXP3_EID, CFE_EVS_EventType_INFORMATION, "CAM App: EXP 3 Command - Large Picture");
             OS_BinSemGive(CAM_AppData.sem_id);
             break;
 
+        /*
+        ** Burst - Several frames back to back
+        */
+        case CAM_BURST_CC:
+            if (CAM_VerifyCmdLength(CAM_AppData.MsgPtr, sizeof(CAM_BurstCmd_t)))
+            {
+                CAM_BurstCmd_t *BurstCmd = (CAM_BurstCmd_t *)CAM_AppData.MsgPtr;
+                if ((BurstCmd->Exp < 1) || (BurstCmd->Exp > 3) || (BurstCmd->Frames < 1) ||
+                    (BurstCmd->Frames > CAM_BURST_MAX_FRAMES))
+                {
+                    OS_MutSemTake(CAM_AppData.data_mutex);
+                    CAM_AppData.HkTelemetryPkt.CommandErrorCount++;
+                    OS_MutSemGive(CAM_AppData.data_mutex);
+                    CFE_EVS_SendEvent(CAM_BURST_ERR_EID, CFE_EVS_EventType_ERROR,
+                                      "CAM App: BURST Command - Invalid EXP %d or frames %d", BurstCmd->Exp,
+                                      BurstCmd->Frames);
+                }
+                else
+                {
+                    OS_MutSemTake(CAM_AppData.data_mutex);
+                    CAM_AppData.HkTelemetryPkt.CommandCount++;
+                    CAM_AppData.Exp    = BurstCmd->Exp;
+                    CAM_AppData.Frames = BurstCmd->Frames;
+                    OS_MutSemGive(CAM_AppData.data_mutex);
+                    CFE_EVS_SendEvent(CAM_BURST_EID, CFE_EVS_EventType_INFORMATION,
+                                      "CAM App: BURST Command - EXP %d, %d frames", BurstCmd->Exp, BurstCmd->Frames);
+                    OS_BinSemGive(CAM_AppData.sem_id);
+                }
+            }
+            break;
+
+        /*
+        ** Set Downlink Rate
+        */
+        case CAM_SET_RATE_CC:
+            if (CAM_VerifyCmdLength(CAM_AppData.MsgPtr, sizeof(CAM_RateCmd_t)))
+            {
+                CAM_RateCmd_t *RateCmd = (CAM_RateCmd_t *)CAM_AppData.MsgPtr;
+                if ((RateCmd->Rate > 0) && (RateCmd->Burst == 0))
+                {
+                    OS_MutSemTake(CAM_AppData.data_mutex);
+                    CAM_AppData.HkTelemetryPkt.CommandErrorCount++;
+                    OS_MutSemGive(CAM_AppData.data_mutex);
+                    CFE_EVS_SendEvent(CAM_RATE_ERR_EID, CFE_EVS_EventType_ERROR,
+                                      "CAM App: SET RATE Command - Burst must be non-zero when throttled");
+                }
+                else
+                {
+                    CAM_rate_set(RateCmd->Rate, RateCmd->Burst);
+                    OS_MutSemTake(CAM_AppData.data_mutex);
+                    CAM_AppData.HkTelemetryPkt.CommandCount++;
+                    OS_MutSemGive(CAM_AppData.data_mutex);
+                    CFE_EVS_SendEvent(CAM_RATE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                                      "CAM App: SET RATE Command - %lu bytes/s, burst %lu bytes",
+                                      (unsigned long)RateCmd->Rate, (unsigned long)RateCmd->Burst);
+                }
+            }
+            break;
+
+        /*
+        ** Set Experiment Packet Data Size
+        */
+        case CAM_SET_DATA_SIZE_CC:
+            if (CAM_VerifyCmdLength(CAM_AppData.MsgPtr, sizeof(CAM_DataSizeCmd_t)))
+            {
+                CAM_DataSizeCmd_t *SizeCmd = (CAM_DataSizeCmd_t *)CAM_AppData.MsgPtr;
+                OS_MutSemTake(CAM_AppData.data_mutex);
+                if ((SizeCmd->DataSize == 0) || (SizeCmd->DataSize > CAM_DATA_SIZE) ||
+                    (CAM_AppData.State != CAM_STOP))
+                {
+                    CAM_AppData.HkTelemetryPkt.CommandErrorCount++;
+                    OS_MutSemGive(CAM_AppData.data_mutex);
+                    CFE_EVS_SendEvent(CAM_DATA_SIZE_ERR_EID, CFE_EVS_EventType_ERROR,
+                                      "CAM App: SET DATA SIZE Command - Invalid size %d or experiment running",
+                                      SizeCmd->DataSize);
+                }
+                else
+                {
+                    CAM_AppData.DataSize = SizeCmd->DataSize;
+                    CAM_AppData.HkTelemetryPkt.CommandCount++;
+                    OS_MutSemGive(CAM_AppData.data_mutex);
+                    // A debug packet sized for the old data size is dropped
+                    if (CAM_AppData.DebugPkt != NULL)
+                    {
+                        CFE_SB_ReleaseMessageBuffer((CFE_SB_Buffer_t *)CAM_AppData.DebugPkt);
+                        CAM_AppData.DebugPkt = NULL;
+                    }
+                    CFE_EVS_SendEvent(CAM_DATA_SIZE_INF_EID, CFE_EVS_EventType_INFORMATION,
+                                      "CAM App: SET DATA SIZE Command - %d bytes", SizeCmd->DataSize);
+                }
+            }
+            break;
+
         /*
         **  Hardware Check
         */
@@ -459,15 +573,28 @@ void CAM_ProcessGroundCommand(void)
             CAM_capture();
             break;
         case CAM_HWLIB_READ_PREP_CC:
-            OS_MutSemTake(CAM_AppData.data_mutex);
-            CAM_AppData.Exp_Pkt.msg_count = 0x0000;
-            OS_MutSemGive(CAM_AppData.data_mutex);
-            CAM_read_prep((char *)&CAM_AppData.Exp_Pkt.data, (uint16 *)&x);
+            if (CAM_AppData.DebugPkt == NULL)
+            {
+                CAM_AppData.DebugPkt = CAM_exp_alloc(CAM_AppData.DataSize);
+            }
+            if (CAM_AppData.DebugPkt != NULL)
+            {
+                OS_MutSemTake(CAM_AppData.data_mutex);
+                CAM_AppData.MsgCount = 0x0000;
+                CAM_AppData.Frame    = 0;
+                CAM_AppData.Length   = 0;
+                OS_MutSemGive(CAM_AppData.data_mutex);
+                CAM_read_prep((char *)&CAM_AppData.DebugPkt->data, (uint16 *)&x);
+                OS_MutSemTake(CAM_AppData.data_mutex);
+                CAM_AppData.FifoLength = CAM_Stats.fifo_length;
+                OS_MutSemGive(CAM_AppData.data_mutex);
+            }
             break;
         case CAM_HWLIB_READ_CC:
-            x     = 1;
+            x     = (CAM_AppData.DebugPkt != NULL) ? 1 : 0;
             state = 1;
-            CAM_fifo(&x, &state);
+            CAM_fifo(CAM_AppData.DebugPkt, &x, &state);
+            CAM_AppData.DebugPkt = NULL;
             break;
 
         /*
@@ -497,6 +624,21 @@ void CAM_ProcessGroundCommand(void)
 void CAM_ReportHousekeeping(void)
 {
     OS_MutSemTake(CAM_AppData.data_mutex);
+    CAM_AppData.HkTelemetryPkt.InitSpiWait     = (uint16)CAM_Wait[CAM_WAIT_INIT_SPI].last_ms;
+    CAM_AppData.HkTelemetryPkt.ConfigWait      = (uint16)CAM_Wait[CAM_WAIT_CONFIG].last_ms;
+    CAM_AppData.HkTelemetryPkt.CapturePrepWait = (uint16)CAM_Wait[CAM_WAIT_CAPTURE_PREP].last_ms;
+    CAM_AppData.HkTelemetryPkt.CaptureWait     = (uint16)CAM_Wait[CAM_WAIT_CAPTURE].last_ms;
+    CAM_AppData.HkTelemetryPkt.DataSize        = CAM_AppData.DataSize;
+    CAM_AppData.HkTelemetryPkt.RateLimit       = CAM_AppData.Rate.Rate;
+    CAM_AppData.HkTelemetryPkt.RateBurst       = CAM_AppData.Rate.Burst;
+    CAM_AppData.HkTelemetryPkt.Backlog         = 0;
+    // Packets of the current image carry the data size it was captured with, not the commanded one
+    if ((CAM_AppData.State == CAM_RUN) && (CAM_AppData.Length > (CAM_AppData.MsgCount * CAM_AppData.ImageSize)))
+    {
+        CAM_AppData.HkTelemetryPkt.Backlog = CAM_AppData.Length - (CAM_AppData.MsgCount * CAM_AppData.ImageSize);
+    }
+    CAM_AppData.HkTelemetryPkt.I2cErrors = CAM_Stats.i2c_errors;
+    CAM_AppData.HkTelemetryPkt.Frames    = CAM_Stats.frames;
     CFE_SB_TimeStampMsg((CFE_MSG_Message_t *)&CAM_AppData.HkTelemetryPkt);
     CFE_SB_TransmitMsg((CFE_MSG_Message_t *)&CAM_AppData.HkTelemetryPkt, true);
     OS_MutSemGive(CAM_AppData.data_mutex);
@@ -515,6 +657,18 @@ void CAM_ResetCounters(void)
     /* Status of commands processed by the CAM App */
     CAM_AppData.HkTelemetryPkt.CommandCount      = 0;
     CAM_AppData.HkTelemetryPkt.CommandErrorCount = 0;
+    OS_MutSemTake(CAM_AppData.data_mutex);
+    CAM_AppData.HkTelemetryPkt.PoolHighWater = CAM_AppData.HkTelemetryPkt.PoolUsed;
+    // The driver updates CAM_Stats unlocked from the child task, so a capture clears them itself
+    if (CAM_AppData.Capturing != 0)
+    {
+        CAM_AppData.StatsReset = 1;
+    }
+    else
+    {
+        CAM_stats_reset();
+    }
+    OS_MutSemGive(CAM_AppData.data_mutex);
     CFE_EVS_SendEvent(CAM_COMMANDRST_INF_EID, CFE_EVS_EventType_INFORMATION, "CAM App: RESET Counters Command");
     return;
 }
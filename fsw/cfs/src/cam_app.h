@@ -30,6 +30,7 @@ ivv-itc@lists.nasa.gov
 #include "cam_version.h"
 #include "cam_device.h"
 #include "cam_child.h"
+#include "cam_rate.h"
 #include "hwlib.h"
 
 /*
@@ -59,7 +60,7 @@ typedef struct
     CFE_MSG_Message_t *MsgPtr;    /* Pointer to msg received on software bus */
     CFE_SB_PipeId_t    CmdPipe;   /* Pipe Id for HK command pipe */
     uint32             RunStatus; /* App run status for controlling the application state */
-    CAM_Exp_tlm_t      Exp_Pkt;   /* Experiment Packet */
+    CAM_Exp_tlm_t     *DebugPkt;  /* Packet filled by the read prep debug command */
 
     /*
     ** Child data
@@ -69,7 +70,34 @@ typedef struct
     uint32 sem_id; /* Semaphore ID */
     uint32 Exp;
     uint32 State;
-    uint32 Size; /* Resolution of picture */
+    uint32 Size;     /* Resolution of picture */
+    uint32 Frames;   /* Frames to capture in one experiment */
+    uint16 DataSize; /* Image bytes per experiment packet */
+
+    /*
+    ** Images staged by the child task for the downlink task
+    */
+    uint32 DownlinkTaskID; /* Task ID of the downlink task */
+    uint32 ImageQueue;     /* Staged images waiting to be published */
+    uint32 FreeQueue;      /* Slots free for staging */
+    uint32 Staged;         /* Images queued or being published */
+    uint8  Capturing;      /* Child task is in an experiment */
+    uint8  Reinit;         /* Camera may have lost power, next experiment applies every stage */
+    uint8  StatsReset;     /* CAM_Stats reset left to the child task at its next frame */
+
+    /*
+    ** Experiment packets are SB buffers owned by the child, only their counters live here
+    */
+    uint32 MsgCount;   /* Packets published for the current image */
+    uint32 Length;     /* Bytes of the current image, 0 until its end is found */
+    uint32 FifoLength; /* FIFO length of the capture the current image came from */
+    uint16 ImageSize;  /* Image bytes per packet the current image was captured with */
+    uint16 Frame;      /* Frame of a burst being published */
+
+    /*
+    ** Downlink pacing
+    */
+    CAM_Rate_t Rate;
 } CAM_AppData_t;
 
 /*
@@ -16,22 +16,78 @@ NASA IV&V
 ivv-itc@lists.nasa.gov
 */
 
+#include <string.h>
+
 #include "cam_child.h"
 
+/*
+** Whole images staged in RAM between the capture and downlink stages
+*/
+#if ((CAM_IMAGE_SLOTS * CAM_IMAGE_SLOT_SIZE) > CAM_IMAGE_MEM_BUDGET)
+#error "CAM_IMAGE_SLOTS * CAM_IMAGE_SLOT_SIZE is over CAM_IMAGE_MEM_BUDGET"
+#endif
+#if (CAM_IMAGE_SLOT_SIZE < (2 * CAM_DATA_SIZE))
+#error "CAM_IMAGE_SLOT_SIZE has to hold at least two experiment packets"
+#endif
+static uint8            CAM_ImageSlot[CAM_IMAGE_SLOTS][CAM_IMAGE_SLOT_SIZE];
+static CAM_Image_t      CAM_Staging;       /* Image the capture stage is filling */
+static CAM_Jpeg_Index_t CAM_Staging_Index; /* Markers of the last frame staged */
+
+/*
+**  Name:  CAM_exp_alloc
+**
+**  Purpose:
+** 		   Get an experiment packet straight from the software bus so the FIFO
+**         is read into the buffer that gets transmitted.
+**         Only room for data_size bytes of image is taken from the bus.
+*/
+CAM_Exp_tlm_t *CAM_exp_alloc(uint16_t data_size)
+{
+    CFE_SB_Buffer_t *BufPtr;
+    size_t           size = CAM_EXP_TLM_HDR_LNGTH + data_size;
+
+    BufPtr = CFE_SB_AllocateMessageBuffer(size);
+    if (BufPtr == NULL)
+    {
+        OS_printf("CAM experiment packet allocation error");
+        return NULL;
+    }
+    CFE_MSG_Init(&BufPtr->Msg, CFE_SB_ValueToMsgId(CAM_EXP_TLM_MID), size);
+
+    return (CAM_Exp_tlm_t *)BufPtr;
+} /* End of CAM_exp_alloc() */
+
 /*
 **  Name:  CAM_publish
 **
 **  Purpose:
 ** 		   Break apart functionality, publish received data.
+**         Ownership of the packet passes to the software bus.
+**         The packet is trimmed to the bytes of data used and paced to the downlink budget.
 */
-int32_t CAM_publish(void)
+int32_t CAM_publish(CAM_Exp_tlm_t *pkt, uint16_t bytes)
 {
+    int32_t result = OS_SUCCESS;
+
+    CFE_ES_PerfLogEntry(CAM_PUBLISH_PERF_ID);
     OS_MutSemTake(CAM_AppData.data_mutex);
-    CAM_AppData.Exp_Pkt.msg_count++;
-    CFE_SB_TimeStampMsg((CFE_MSG_Message_t *)&CAM_AppData.Exp_Pkt);
-    CFE_SB_TransmitMsg((CFE_MSG_Message_t *)&CAM_AppData.Exp_Pkt, true);
+    pkt->msg_count = ++CAM_AppData.MsgCount;
+    pkt->length       = CAM_AppData.FifoLength;
+    pkt->frame_length = CAM_AppData.Length;
+    pkt->frame        = CAM_AppData.Frame;
     OS_MutSemGive(CAM_AppData.data_mutex);
-    return OS_SUCCESS;
+    pkt->size = bytes;
+    CFE_MSG_SetSize(&((CFE_SB_Buffer_t *)pkt)->Msg, CAM_EXP_TLM_HDR_LNGTH + bytes);
+
+    CAM_rate_wait(CAM_EXP_TLM_HDR_LNGTH + bytes);
+    CFE_SB_TimeStampMsg(&((CFE_SB_Buffer_t *)pkt)->Msg);
+    if (CFE_SB_TransmitBuffer((CFE_SB_Buffer_t *)pkt, true) != CFE_SUCCESS)
+    {
+        CFE_SB_ReleaseMessageBuffer((CFE_SB_Buffer_t *)pkt);
+        result = OS_ERROR;
+    }
+    CFE_ES_PerfLogExit(CAM_PUBLISH_PERF_ID);
+    return result;
 } /* End of CAM_publish() */
 
 /*
@@ -90,20 +146,37 @@ int32_t CAM_state(void)
 **
 **  Purpose:
 ** 		   Read the camera FIFO until commanded to stop, complete, or error occurs.
+**         Starts filling pkt when given one, otherwise each packet is a new SB buffer.
 */
-int32_t CAM_fifo(uint16 *x, uint8 *status)
+int32_t CAM_fifo(CAM_Exp_tlm_t *pkt, uint16 *x, uint8 *status)
 {
-    int32_t result = OS_SUCCESS;
+    int32_t  result = OS_SUCCESS;
+    uint16_t bytes;
+    uint16_t size;
+
+    OS_MutSemTake(CAM_AppData.data_mutex);
+    size = CAM_AppData.DataSize;
+    OS_MutSemGive(CAM_AppData.data_mutex);
 
-    while ((*status > 0) && (*status <= 8) &&
-           (CAM_AppData.Exp_Pkt.msg_count < ((CAM_AppData.Exp_Pkt.length / CAM_DATA_SIZE) + 1)))
+    while ((*status > 0) && (*status <= 8) && (CAM_AppData.MsgCount < ((CAM_AppData.FifoLength / size) + 1)))
     // Status is used to track key points such as start and end of the image
     // Limiting this number ensures that cycling through the FIFO repeatedly is avoided
     {
+        if (pkt == NULL)
+        {
+            pkt = CAM_exp_alloc(size);
+            if (pkt == NULL)
+            {
+                result = OS_ERROR;
+                OS_MutSemTake(CAM_AppData.data_mutex);
+                CAM_AppData.State = CAM_STOP;
+                OS_MutSemGive(CAM_AppData.data_mutex);
+                break;
+            }
+        }
+
         // Read a packet
-        OS_MutSemTake(CAM_AppData.data_mutex);
-        result = CAM_read((char *)&CAM_AppData.Exp_Pkt.data, x, status);
-        OS_MutSemGive(CAM_AppData.data_mutex);
+        result = CAM_read((char *)&pkt->data, x, size, status);
         if (result != OS_SUCCESS)
         {
             OS_printf("CAM read error");
@@ -113,10 +186,12 @@ int32_t CAM_fifo(uint16 *x, uint8 *status)
         }
         if (CAM_state() != OS_SUCCESS)
             break;
-        (*x) = 0;
+        bytes = *x;
+        (*x)  = 0;
 
         // Publish the packet
-        result = CAM_publish();
+        result = CAM_publish(pkt, bytes);
+        pkt    = NULL;
         if (result != OS_SUCCESS)
         {
             OS_printf("CAM publish error");
@@ -127,126 +202,201 @@ int32_t CAM_fifo(uint16 *x, uint8 *status)
         if (CAM_state() != OS_SUCCESS)
             break;
 
-        // Delay between messages to allow for processing
-        OS_TaskDelay(250);
-
 #ifdef STF1_DEBUG
         OS_MutSemTake(CAM_AppData.data_mutex);
         OS_printf("\n status   = %d \n", *status);
-        OS_printf("\n msg_count = %d \n", CAM_AppData.Exp_Pkt.msg_count);
+        OS_printf("\n msg_count = %d \n", CAM_AppData.MsgCount);
         OS_MutSemGive(CAM_AppData.data_mutex);
 #endif
     }
+
+    // A packet that was never published goes back to the bus
+    if (pkt != NULL)
+    {
+        CFE_SB_ReleaseMessageBuffer((CFE_SB_Buffer_t *)pkt);
+    }
     return result;
 }
 
 /*
-**  Name:  CAM_exp
+**  Name:  CAM_slot_put
 **
 **  Purpose:
-** 		   The experiment runs until the parent dies or is commanded to stop by the parent
-** 		   but has the ability to be paused and resumed depending on the current state.
+** 		   Give a staging slot back to the capture stage.
 */
-int32_t CAM_exp(void)
+static void CAM_slot_put(uint8 *slot)
 {
-    int32_t result = OS_ERROR;
-    uint8   status = 1;
-    uint16  x      = 0;
+    OS_MutSemTake(CAM_AppData.data_mutex);
+    CAM_AppData.HkTelemetryPkt.PoolUsed--;
+    OS_MutSemGive(CAM_AppData.data_mutex);
+    OS_QueuePut(CAM_AppData.FreeQueue, &slot, sizeof(slot), 0);
+}
 
-    while (status == 1)
-    { // Check state
-        if (CAM_state() != OS_SUCCESS)
-            break;
+/*
+**  Name:  CAM_stats_pending
+**
+**  Purpose:
+** 		   Clear CAM_Stats for a reset counters command that came in during
+**         a capture, called with data_mutex held between driver calls.
+*/
+static void CAM_stats_pending(void)
+{
+    if (CAM_AppData.StatsReset != 0)
+    {
+        CAM_AppData.StatsReset = 0;
+        CAM_stats_reset();
+    }
+}
 
-        // Initialize Serial Peripheral Interface
-        result = CAM_init_spi();
-        if (result != OS_SUCCESS)
-        {
-            OS_printf("CAM init spi error");
-            OS_MutSemTake(CAM_AppData.data_mutex);
-            CAM_AppData.State = CAM_STOP;
-            OS_MutSemGive(CAM_AppData.data_mutex);
-        }
-        if (CAM_state() != OS_SUCCESS)
-            break;
+/*
+**  Name:  CAM_stage_next
+**
+**  Purpose:
+** 		   Start staging a new image in a free slot, waits for the downlink
+**         stage to give one back when they are all in use.
+*/
+int32_t CAM_stage_next(char **buf)
+{
+    uint8 *slot = NULL;
+    size_t size;
 
-        // Initialize Inter-Integrated Circuit
-        result = CAM_init_i2c();
-        if (result != OS_SUCCESS)
-        {
-            OS_printf("CAM init i2c error");
-            OS_MutSemTake(CAM_AppData.data_mutex);
-            CAM_AppData.State = CAM_STOP;
-            OS_MutSemGive(CAM_AppData.data_mutex);
-        }
-        if (CAM_state() != OS_SUCCESS)
-            break;
+    if (OS_QueueGet(CAM_AppData.FreeQueue, &slot, sizeof(slot), &size, OS_PEND) != OS_SUCCESS)
+    {
+        OS_printf("CAM image slot error");
+        *buf = NULL;
+        return OS_ERROR;
+    }
+    OS_MutSemTake(CAM_AppData.data_mutex);
+    CAM_AppData.HkTelemetryPkt.PoolUsed++;
+    if (CAM_AppData.HkTelemetryPkt.PoolUsed > CAM_AppData.HkTelemetryPkt.PoolHighWater)
+    {
+        CAM_AppData.HkTelemetryPkt.PoolHighWater = CAM_AppData.HkTelemetryPkt.PoolUsed;
+    }
+    OS_MutSemGive(CAM_AppData.data_mutex);
+    CAM_Staging.data   = slot;
+    CAM_Staging.length = 0;
+    CAM_Staging.frame  = 0;
+    *buf               = (char *)slot;
 
-        // Configure Camera for Upload
-        result = CAM_config();
-        if (result != OS_SUCCESS)
-        {
-            OS_printf("CAM configure camera for upload error");
-            OS_MutSemTake(CAM_AppData.data_mutex);
-            CAM_AppData.State = CAM_STOP;
-            OS_MutSemGive(CAM_AppData.data_mutex);
-        }
-        if (CAM_state() != OS_SUCCESS)
-            break;
+    return OS_SUCCESS;
+}
 
-        // Configure Registers
-        result = CAM_jpeg_init();
-        if (result != OS_SUCCESS)
-        {
-            OS_printf("CAM jpeg init error");
-            OS_MutSemTake(CAM_AppData.data_mutex);
-            CAM_AppData.State = CAM_STOP;
-            OS_MutSemGive(CAM_AppData.data_mutex);
-        }
-        if (CAM_state() != OS_SUCCESS)
-            break;
+/*
+**  Name:  CAM_stage_first
+**
+**  Purpose:
+** 		   Start staging the first frame of a capture, frames and data_size
+**         go with every image staged until the last frame.
+*/
+int32_t CAM_stage_first(char **buf, uint16_t frames, uint16_t data_size)
+{
+    CAM_Staging.frames    = frames;
+    CAM_Staging.data_size = data_size;
+    return CAM_stage_next(buf);
+}
 
-        // Configure Registers
-        result = CAM_yuv422();
-        if (result != OS_SUCCESS)
-        {
-            OS_printf("CAM yuv422 error");
-            OS_MutSemTake(CAM_AppData.data_mutex);
-            CAM_AppData.State = CAM_STOP;
-            OS_MutSemGive(CAM_AppData.data_mutex);
-        }
-        if (CAM_state() != OS_SUCCESS)
-            break;
+/*
+**  Name:  CAM_stage_sink
+**
+**  Purpose:
+** 		   Collect each piece drained from the FIFO in the staging slot,
+**         a finished frame is queued for the downlink stage.
+*/
+int32_t CAM_stage_sink(uint8_t frame, char **buf, uint16_t length, uint8_t eoi)
+{
+    CAM_Image_t image;
 
-        // Configure Registers
-        result = CAM_jpeg();
-        if (result != OS_SUCCESS)
+    CAM_Staging.length += length;
+    CAM_Staging.fifo_length = CAM_Stats.fifo_length;
+    CAM_Staging.frame       = frame;
+
+    if (eoi == 0)
+    {
+        // The next piece has to fit behind this one
+        if ((CAM_Staging.length + CAM_DATA_SIZE) > CAM_IMAGE_SLOT_SIZE)
         {
-            OS_printf("CAM jpeg error");
-            OS_MutSemTake(CAM_AppData.data_mutex);
-            CAM_AppData.State = CAM_STOP;
-            OS_MutSemGive(CAM_AppData.data_mutex);
+            OS_printf("CAM image larger than a slot");
+            return OS_ERROR;
         }
+        *buf += length;
+        return OS_SUCCESS;
+    }
+
+    // Whole frame is in RAM, check its structure and drop anything after the end of image
+    if (CAM_jpeg_index(CAM_Staging.data, CAM_Staging.length, &CAM_Staging_Index) == OS_SUCCESS)
+    {
+        CAM_Staging.length = CAM_Staging_Index.length;
+    }
+    else
+    {
+        OS_printf("CAM frame %d is not a complete JPEG", frame);
+    }
+
+    // Hand it over
+    image            = CAM_Staging;
+    CAM_Staging.data = NULL;
+    *buf             = NULL;
+
+    OS_MutSemTake(CAM_AppData.data_mutex);
+    CAM_AppData.Staged++;
+    CAM_stats_pending();
+    OS_MutSemGive(CAM_AppData.data_mutex);
+    if (OS_QueuePut(CAM_AppData.ImageQueue, &image, sizeof(image), 0) != OS_SUCCESS)
+    {
+        OS_printf("CAM image queue error");
+        OS_MutSemTake(CAM_AppData.data_mutex);
+        CAM_AppData.Staged--;
+        OS_MutSemGive(CAM_AppData.data_mutex);
+        CAM_slot_put(image.data);
+        return OS_ERROR;
+    }
+
+#ifdef STF1_DEBUG
+    OS_printf("\n frame %d staged, %u bytes \n", frame, (unsigned int)image.length);
+#endif
+    if (CAM_state() != OS_SUCCESS)
+        return OS_ERROR;
+
+    // Next frame goes in its own slot, there is no waiting for one after the last
+    if ((frame + 1) >= CAM_Staging.frames)
+        return OS_SUCCESS;
+    return CAM_stage_next(buf);
+}
+
+/*
+**  Name:  CAM_exp
+**
+**  Purpose:
+** 		   The capture stage of an experiment, every frame is drained from the FIFO
+** 		   into RAM so the sensor is free again while the downlink stage publishes.
+**         Runs with the experiment settings the child task took when it was started.
+*/
+int32_t CAM_exp(uint32_t size, uint16_t frames, uint16_t data_size)
+{
+    int32_t   result = OS_ERROR;
+    uint8     status = 1;
+    char     *buf    = NULL;
+    OS_time_t start;
+    OS_time_t now;
+    uint32    elapsed;
+
+    while (status == 1)
+    { // Check state
         if (CAM_state() != OS_SUCCESS)
             break;
 
-        // Configure Camera for Size
-        result = CAM_setup();
-        if (result != OS_SUCCESS)
+        // Bring up the camera, stages already applied are skipped unless it may have been powered off
+        OS_MutSemTake(CAM_AppData.data_mutex);
+        if (CAM_AppData.Reinit != 0)
         {
-            OS_printf("CAM setup error");
-            OS_MutSemTake(CAM_AppData.data_mutex);
-            CAM_AppData.State = CAM_STOP;
-            OS_MutSemGive(CAM_AppData.data_mutex);
+            CAM_AppData.Reinit = 0;
+            CAM_session_close();
         }
-        if (CAM_state() != OS_SUCCESS)
-            break;
-
-        // Upload Size
-        result = CAM_setSize(CAM_AppData.Size);
+        OS_MutSemGive(CAM_AppData.data_mutex);
+        result = CAM_session_open(size);
         if (result != OS_SUCCESS)
         {
-            OS_printf("CAM upload size error");
+            OS_printf("CAM session open error");
             OS_MutSemTake(CAM_AppData.data_mutex);
             CAM_AppData.State = CAM_STOP;
             OS_MutSemGive(CAM_AppData.data_mutex);
@@ -254,20 +404,23 @@ int32_t CAM_exp(void)
         if (CAM_state() != OS_SUCCESS)
             break;
 
-        // Prepare for Capture
-        result = CAM_capture_prep();
-        if (result != OS_SUCCESS)
+        // Capture and stage each frame, bursts drain each FIFO fill before the next capture
+        result = CAM_stage_first(&buf, frames, data_size);
+        if (result == OS_SUCCESS)
         {
-            OS_printf("CAM capture prep error");
+            OS_GetLocalTime(&start);
+            result = CAM_capture_burst(frames, &buf, CAM_DATA_SIZE, CAM_stage_sink);
+            OS_GetLocalTime(&now);
+            elapsed = (uint32)OS_TimeGetTotalMilliseconds(OS_TimeSubtract(now, start));
+
             OS_MutSemTake(CAM_AppData.data_mutex);
-            CAM_AppData.State = CAM_STOP;
+            CAM_AppData.HkTelemetryPkt.FifoLength      = CAM_Stats.fifo_length;
+            CAM_AppData.HkTelemetryPkt.BytesRead       = CAM_Stats.bytes_read;
+            CAM_AppData.HkTelemetryPkt.SpiTransactions = CAM_Stats.spi_transactions;
+            CAM_AppData.HkTelemetryPkt.ReadoutTime =
+                (elapsed > CAM_Stats.capture_ms) ? (elapsed - CAM_Stats.capture_ms) : 0;
             OS_MutSemGive(CAM_AppData.data_mutex);
         }
-        if (CAM_state() != OS_SUCCESS)
-            break;
-
-        // Capture Image
-        result = CAM_capture();
         if (result != OS_SUCCESS)
         {
             OS_printf("CAM capture error");
@@ -275,41 +428,88 @@ int32_t CAM_exp(void)
             CAM_AppData.State = CAM_STOP;
             OS_MutSemGive(CAM_AppData.data_mutex);
         }
-        if (CAM_state() != OS_SUCCESS)
-            break;
+        break;
+    }
 
-        // Read FIFO Size
-        result = CAM_read_fifo_length(&CAM_AppData.Exp_Pkt.length);
-        if (result != OS_SUCCESS)
-        {
-            OS_printf("CAM read fifo length error");
-            OS_MutSemTake(CAM_AppData.data_mutex);
-            CAM_AppData.State = CAM_STOP;
-            OS_MutSemGive(CAM_AppData.data_mutex);
-        }
+    // The slot staged last is never queued
+    if (CAM_Staging.data != NULL)
+    {
+        CAM_slot_put(CAM_Staging.data);
+        CAM_Staging.data = NULL;
+    }
+
+    // Start from scratch next time if anything went wrong
+    if (result != OS_SUCCESS)
+    {
+        CAM_session_close();
+    }
+
+    return result;
+}
+
+/*
+**  Name:  CAM_downlink
+**
+**  Purpose:
+** 		   Packetize and publish one staged image until commanded to stop, complete, or error occurs.
+*/
+int32_t CAM_downlink(CAM_Image_t *image)
+{
+    int32_t        result = OS_SUCCESS;
+    CAM_Exp_tlm_t *pkt;
+    uint32         offset = 0;
+    uint16         bytes;
+    uint16         size;
+    OS_time_t      start;
+    OS_time_t      now;
+    uint32         elapsed;
+
+    OS_GetLocalTime(&start);
+    OS_MutSemTake(CAM_AppData.data_mutex);
+    CAM_AppData.MsgCount   = 0x0000;
+    CAM_AppData.Length     = image->length;
+    CAM_AppData.FifoLength = image->fifo_length;
+    CAM_AppData.ImageSize  = image->data_size;
+    CAM_AppData.Frame      = image->frame;
+    OS_MutSemGive(CAM_AppData.data_mutex);
+    size = image->data_size;
+
+    while ((offset < image->length) && (result == OS_SUCCESS))
+    {
         if (CAM_state() != OS_SUCCESS)
             break;
 
-        // Prepare for FIFO Read
-        OS_MutSemTake(CAM_AppData.data_mutex);
-        CAM_AppData.Exp_Pkt.msg_count = 0x0000;
-        result                        = CAM_read_prep((char *)&CAM_AppData.Exp_Pkt.data, (uint16 *)&x);
-        OS_MutSemGive(CAM_AppData.data_mutex);
-        if (result != OS_SUCCESS)
+        pkt = CAM_exp_alloc(size);
+        if (pkt == NULL)
         {
-            OS_printf("CAM read prep error");
-            OS_MutSemTake(CAM_AppData.data_mutex);
-            CAM_AppData.State = CAM_STOP;
-            OS_MutSemGive(CAM_AppData.data_mutex);
-        }
-        if (CAM_state() != OS_SUCCESS)
+            result = OS_ERROR;
             break;
+        }
 
-        // Read FIFO
-        result = CAM_fifo((uint16 *)&x, (uint8 *)&status);
-        break;
+        bytes = ((image->length - offset) < size) ? (uint16)(image->length - offset) : size;
+        memcpy(pkt->data, &image->data[offset], bytes);
+        offset += bytes;
+
+        // Publish the packet
+        result = CAM_publish(pkt, bytes);
     }
 
+    // Rate over the whole image, pacing included
+    OS_GetLocalTime(&now);
+    elapsed = (uint32)OS_TimeGetTotalMilliseconds(OS_TimeSubtract(now, start));
+    OS_MutSemTake(CAM_AppData.data_mutex);
+    CAM_AppData.HkTelemetryPkt.PacketsSent = CAM_AppData.MsgCount;
+    CAM_AppData.HkTelemetryPkt.PublishTime = elapsed;
+    CAM_AppData.HkTelemetryPkt.Throughput  = (uint32)(((uint64)offset * 1000) / ((elapsed > 0) ? elapsed : 1));
+    OS_MutSemGive(CAM_AppData.data_mutex);
+
+    if (result != OS_SUCCESS)
+    {
+        OS_printf("CAM publish error");
+        OS_MutSemTake(CAM_AppData.data_mutex);
+        CAM_AppData.State = CAM_STOP;
+        OS_MutSemGive(CAM_AppData.data_mutex);
+    }
     return result;
 }
 
@@ -319,6 +519,35 @@ int32_t CAM_exp(void)
 int32_t CAM_ChildInit(void)
 {
     int32_t result;
+    uint8  *slot;
+    uint32  n;
+
+    /* Queues of staged images and of the slots free to stage them in */
+    result = OS_QueueCreate(&CAM_AppData.ImageQueue, CAM_IMAGE_QUEUE_NAME, CAM_IMAGE_SLOTS, sizeof(CAM_Image_t), 0);
+    if (result == OS_SUCCESS)
+    {
+        result = OS_QueueCreate(&CAM_AppData.FreeQueue, CAM_FREE_QUEUE_NAME, CAM_IMAGE_SLOTS, sizeof(slot), 0);
+    }
+    for (n = 0; (n < CAM_IMAGE_SLOTS) && (result == OS_SUCCESS); n++)
+    {
+        slot   = CAM_ImageSlot[n];
+        result = OS_QueuePut(CAM_AppData.FreeQueue, &slot, sizeof(slot), 0);
+    }
+    if (result != OS_SUCCESS)
+    {
+        OS_printf("CAM child task initialization error: image queues failed: result = %d", result);
+        return result;
+    }
+    CAM_Staging.data = NULL;
+
+    /* Create downlink task, publishes staged images */
+    result = CFE_ES_CreateChildTask(&CAM_AppData.DownlinkTaskID, CAM_DOWNLINK_TASK_NAME, CAM_DownlinkTask, 0,
+                                    CAM_DOWNLINK_STACK_SIZE, CAM_DOWNLINK_PRIORITY, 0);
+    if (result != CFE_SUCCESS)
+    {
+        OS_printf("CAM downlink task initialization error: create task failed: result = %d", result);
+        return result;
+    }
 
     /* Create child task (low priority command handler) */
     result = CFE_ES_CreateChildTask(&CAM_AppData.ChildTaskID, CAM_CHILD_TASK_NAME, CAM_ChildTask, 0,
@@ -341,15 +570,21 @@ int32_t CAM_ChildInit(void)
 */
 void CAM_ChildTask(void)
 {
-    int32_t result;
-    int32_t state;
+    int32_t  result;
+    int32_t  state;
+    uint32_t size = 0;
+    uint16_t frames;
+    uint16_t data_size;
 
     OS_printf("CAM child task initialization complete");
+    CFE_ES_PerfLogEntry(CAM_CHILD_TASK_PERF_ID);
 
     while (true)
     {
         // Block on Semaphore
+        CFE_ES_PerfLogExit(CAM_CHILD_TASK_PERF_ID);
         OS_BinSemTake(CAM_AppData.sem_id);
+        CFE_ES_PerfLogEntry(CAM_CHILD_TASK_PERF_ID);
 
         // Check State
         OS_MutSemTake(CAM_AppData.data_mutex);
@@ -361,9 +596,13 @@ void CAM_ChildTask(void)
                 ;
         }
 
-        // Initialize Child Process Flags
+        // Initialize Child Process Flags, the experiment runs with the settings of the command that started it
         OS_MutSemTake(CAM_AppData.data_mutex);
-        CAM_AppData.State = CAM_RUN;
+        CAM_AppData.State     = CAM_RUN;
+        CAM_AppData.Capturing = 1;
+        frames                = (uint16_t)CAM_AppData.Frames;
+        data_size             = CAM_AppData.DataSize;
+        CAM_Staging.exp       = (uint8)CAM_AppData.Exp;
         switch (CAM_AppData.Exp)
         {
             case 1:
@@ -404,40 +643,114 @@ void CAM_ChildTask(void)
                 CAM_AppData.State = CAM_STOP;
                 break;
         }
+        size = CAM_AppData.Size;
         OS_MutSemGive(CAM_AppData.data_mutex);
 
-        // Run Experiment
-        result = CAM_exp();
-        // Check Result
+        // Run Experiment, the downlink task reports it complete once the last frame is out
+        result = CAM_exp(size, frames, data_size);
+        if (result != OS_SUCCESS)
+        {
+            OS_printf("CAM experiment error: result = %d", (int)result);
+        }
+
+        // Cleanup, the downlink stage stops once it has published everything staged
         OS_MutSemTake(CAM_AppData.data_mutex);
-        if ((result == OS_SUCCESS) && (CAM_AppData.State == CAM_RUN))
+        CAM_stats_pending();
+        CAM_AppData.Capturing = 0;
+        if (CAM_AppData.Staged == 0)
         {
-            switch (CAM_AppData.Exp)
-            {
-                case 1:
-                    // OS_printf("CAM EXP1 Complete\n");
-                    CFE_EVS_SendEvent(CAM_EXP3_EID, CFE_EVS_EventType_INFORMATION, "CAM App: EXP 1 Completed");
-                    break;
-                case 2:
-                    // OS_printf("CAM EXP2 Complete\n");
-                    CFE_EVS_SendEvent(CAM_EXP3_EID, CFE_EVS_EventType_INFORMATION, "CAM App: EXP 2 Completed");
-                    break;
-                case 3:
-                    // OS_printf("CAM EXP3 Complete\n");
-                    CFE_EVS_SendEvent(CAM_EXP3_EID, CFE_EVS_EventType_INFORMATION, "CAM App: EXP 3 Completed");
-                    break;
-                default:
-                    break;
-            }
-            // Delay to allow for all CAM Tlm messages to be cleared from pipe
-            OS_TaskDelay(10000);
+            CAM_AppData.State = CAM_STOP;
         }
-        // Cleanup
-        CAM_AppData.State = CAM_STOP;
         OS_MutSemGive(CAM_AppData.data_mutex);
     }
 
     /* This call allows cFE to clean-up system resources */
+    CFE_ES_PerfLogExit(CAM_CHILD_TASK_PERF_ID);
     OS_printf("CAM child task exit complete");
     CFE_ES_ExitChildTask();
 } /* End of CAM_ChildTask() */
+
+/*
+**  Name:  CAM_complete
+**
+**  Purpose:
+** 		   Report an experiment complete once its last frame has been published.
+*/
+static void CAM_complete(CAM_Image_t *image)
+{
+    if (image->frames > 1)
+    {
+        CFE_EVS_SendEvent(CAM_BURST_EID, CFE_EVS_EventType_INFORMATION, "CAM App: BURST of %d frames Completed",
+                          (int)image->frames);
+        return;
+    }
+    switch (image->exp)
+    {
+        case 1:
+            // OS_printf("CAM EXP1 Complete\n");
+            CFE_EVS_SendEvent(CAM_EXP3_EID, CFE_EVS_EventType_INFORMATION, "CAM App: EXP 1 Completed");
+            break;
+        case 2:
+            // OS_printf("CAM EXP2 Complete\n");
+            CFE_EVS_SendEvent(CAM_EXP3_EID, CFE_EVS_EventType_INFORMATION, "CAM App: EXP 2 Completed");
+            break;
+        case 3:
+            // OS_printf("CAM EXP3 Complete\n");
+            CFE_EVS_SendEvent(CAM_EXP3_EID, CFE_EVS_EventType_INFORMATION, "CAM App: EXP 3 Completed");
+            break;
+        default:
+            break;
+    }
+}
+
+/*
+**  Name:  CAM_DownlinkTask
+**
+**  Purpose:
+** 		   The downlink task publishes each image the child task stages, so the next
+**         capture can start while the previous image is still going out.
+*/
+void CAM_DownlinkTask(void)
+{
+    CAM_Image_t image;
+    size_t      size;
+    int32_t     result;
+
+    OS_printf("CAM downlink task initialization complete");
+    CFE_ES_PerfLogEntry(CAM_DOWNLINK_TASK_PERF_ID);
+
+    while (true)
+    {
+        // Block on the next staged image
+        CFE_ES_PerfLogExit(CAM_DOWNLINK_TASK_PERF_ID);
+        result = OS_QueueGet(CAM_AppData.ImageQueue, &image, sizeof(image), &size, OS_PEND);
+        CFE_ES_PerfLogEntry(CAM_DOWNLINK_TASK_PERF_ID);
+        if (result != OS_SUCCESS)
+        {
+            OS_TaskDelay(1000);
+            continue;
+        }
+
+        // Anything staged before a stop is dropped
+        if ((CAM_state() == OS_SUCCESS) && (CAM_downlink(&image) == OS_SUCCESS) &&
+            ((image.frame + 1) == image.frames) && (CAM_state() == OS_SUCCESS))
+        {
+            CAM_complete(&image);
+        }
+
+        // Slot is free for the child task again
+        CAM_slot_put(image.data);
+        OS_MutSemTake(CAM_AppData.data_mutex);
+        CAM_AppData.Staged--;
+        if ((CAM_AppData.Staged == 0) && (CAM_AppData.Capturing == 0) && (CAM_AppData.State == CAM_RUN))
+        {
+            CAM_AppData.State = CAM_STOP;
+        }
+        OS_MutSemGive(CAM_AppData.data_mutex);
+    }
+
+    /* This call allows cFE to clean-up system resources */
+    CFE_ES_PerfLogExit(CAM_DOWNLINK_TASK_PERF_ID);
+    OS_printf("CAM downlink task exit complete");
+    CFE_ES_ExitChildTask();
+} /* End of CAM_DownlinkTask() */
@@ -23,11 +23,32 @@ ivv-itc@lists.nasa.gov
 #include "cam_app.h"
 #include "cam_platform_cfg.h"
 
-int32_t CAM_publish(void);
-int32_t CAM_state(void);
-int32_t CAM_fifo(uint16_t *, uint8_t *);
-int32_t CAM_exp(void);
-int32_t CAM_ChildInit(void);
-void    CAM_ChildTask(void);
+/*
+** Whole image staged in RAM, the experiment settings travel with it so
+** commands received since the capture do not change how it is published
+*/
+typedef struct
+{
+    uint8 *data;        /* Start of the image in its slot */
+    uint32 length;      /* Bytes of the image */
+    uint32 fifo_length; /* FIFO length of the capture it came from */
+    uint16 frame;       /* Frame of a burst, from 0 */
+    uint16 frames;      /* Frames in the experiment */
+    uint16 data_size;   /* Image bytes per experiment packet */
+    uint8  exp;         /* Experiment that captured it */
+} CAM_Image_t;
+
+CAM_Exp_tlm_t *CAM_exp_alloc(uint16_t);
+int32_t        CAM_publish(CAM_Exp_tlm_t *, uint16_t);
+int32_t        CAM_state(void);
+int32_t        CAM_fifo(CAM_Exp_tlm_t *, uint16_t *, uint8_t *);
+int32_t        CAM_stage_next(char **);
+int32_t        CAM_stage_first(char **, uint16_t, uint16_t);
+int32_t        CAM_stage_sink(uint8_t, char **, uint16_t, uint8_t);
+int32_t        CAM_exp(uint32_t, uint16_t, uint16_t);
+int32_t        CAM_downlink(CAM_Image_t *);
+int32_t        CAM_ChildInit(void);
+void           CAM_ChildTask(void);
+void           CAM_DownlinkTask(void);
 
 #endif /* _cam_child_h_ */
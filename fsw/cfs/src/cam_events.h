@@ -37,6 +37,8 @@ ivv-itc@lists.nasa.gov
 #define CAM_INIT_PIPE_ERR_EID     14
 #define CAM_INIT_SUB_CMD_ERR_EID  15
 #define CAM_INIT_SUB_HK_ERR_EID   16
+#define CAM_RATE_INF_EID          17
+#define CAM_DATA_SIZE_INF_EID     18
 
 /* Child Task IDs */
 #define CAM_STOP_INF_EID        20
@@ -57,6 +59,7 @@ ivv-itc@lists.nasa.gov
 #define CAM_EXP2_EID     41
 #define CAM_EXP3_EID     42
 #define CAM_HW_CHECK_EID 43
+#define CAM_BURST_EID    44
 
 /* Errors */
 #define CAM_INIT_SPI_ERR_EID      61
@@ -75,5 +78,8 @@ ivv-itc@lists.nasa.gov
 #define CAM_PUBLISH_ERR_EID       74
 #define CAM_LOW_VOLTAGE_EID       75
 #define CAM_TIME_EID              76
+#define CAM_BURST_ERR_EID         77
+#define CAM_RATE_ERR_EID          78
+#define CAM_DATA_SIZE_ERR_EID     79
 
 #endif
\ No newline at end of file
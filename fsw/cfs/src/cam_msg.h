@@ -51,6 +51,12 @@ ivv-itc@lists.nasa.gov
 #define CAM_EXP3_CC 12
 // \camcmd CAM Hardware Check
 #define CAM_HW_CHECK_CC 13
+// \camcmd CAM Burst - Several frames back to back
+#define CAM_BURST_CC 14
+// \camcmd CAM Set Downlink Rate
+#define CAM_SET_RATE_CC 15
+// \camcmd CAM Set Experiment Packet Data Size
+#define CAM_SET_DATA_SIZE_CC 16
 
 /* Debug and Testing CC */
 #define CAM_HWLIB_INIT_I2C_CC     20
@@ -67,8 +73,6 @@ ivv-itc@lists.nasa.gov
 #define CAM_HWLIB_READ_CC         31
 #define CAM_PUBLISH_CC            32
 
-#define CAM_DATA_SIZE 1010 // Necessary to avoid compiler errors
-
 /*
 ** CAM no argument command
 ** See also: #CAM_NOOP_CC, #CAM_RESET_COUNTER_CC, #CAM_STOP_CC,
@@ -82,6 +86,44 @@ typedef struct
 } CAM_NoArgsCmd_t;
 #define CAM_NOARGSCMD_LNGTH sizeof(CAM_NoArgsCmd_t)
 
+/*
+** CAM burst command
+** See also: #CAM_BURST_CC
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader;
+    uint8                   Exp;    /* Image size as in experiment 1, 2, or 3 */
+    uint8                   Frames; /* Frames to capture, 1 to CAM_BURST_MAX_FRAMES */
+
+} CAM_BurstCmd_t;
+#define CAM_BURSTCMD_LNGTH sizeof(CAM_BurstCmd_t)
+
+/*
+** CAM set rate command
+** See also: #CAM_SET_RATE_CC
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader;
+    uint32                  Rate;  /* Experiment telemetry bytes per second, 0 is unthrottled */
+    uint32                  Burst; /* Bytes that may be sent back to back */
+
+} CAM_RateCmd_t;
+#define CAM_RATECMD_LNGTH sizeof(CAM_RateCmd_t)
+
+/*
+** CAM set data size command
+** See also: #CAM_SET_DATA_SIZE_CC
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader;
+    uint16                  DataSize; /* Image bytes per experiment packet, 1 to CAM_DATA_SIZE */
+
+} CAM_DataSizeCmd_t;
+#define CAM_DATASIZECMD_LNGTH sizeof(CAM_DataSizeCmd_t)
+
 /*
 ** Type definition (CAM housekeeping)
 ** \camtlm CAM Housekeeping telemetry packet
@@ -92,6 +134,25 @@ typedef struct
     CFE_MSG_TelemetryHeader_t TlmHeader;
     uint8                     CommandErrorCount;
     uint8                     CommandCount;
+    uint16                    InitSpiWait;     /* Last ArduChip mode handshake wait (ms) */
+    uint16                    ConfigWait;      /* Last sensor reset wait (ms) */
+    uint16                    CapturePrepWait; /* Last capture done flag clear wait (ms) */
+    uint16                    CaptureWait;     /* Last capture done wait (ms) */
+    uint16                    DataSize;  /* Image bytes per experiment packet */
+    uint32                    RateLimit; /* Downlink rate in bytes per second, 0 is unthrottled */
+    uint32                    RateBurst; /* Downlink burst size in bytes */
+    uint32                    Backlog;   /* Bytes of the current image not yet published */
+    uint16                    PoolUsed;      /* Image staging slots in use */
+    uint16                    PoolHighWater; /* Most image staging slots in use at once */
+    uint32                    FifoLength;      /* FIFO length of the last capture */
+    uint32                    BytesRead;       /* Bytes clocked out of the FIFO for the last capture */
+    uint32                    PacketsSent;     /* Experiment packets published for the last image */
+    uint32                    ReadoutTime;     /* Last capture time less the capture done wait (ms) */
+    uint32                    PublishTime;     /* Last image publish time (ms) */
+    uint32                    Throughput;      /* Last image bytes published per second */
+    uint32                    SpiTransactions; /* SPI transactions for the last capture */
+    uint32                    I2cErrors;       /* Register write errors tolerated since reset */
+    uint32                    Frames;          /* Frames read out since reset */
 
 } CAM_Hk_tlm_t;
 #define CAM_HK_TLM_LNGTH sizeof(CAM_Hk_tlm_t)
@@ -101,15 +162,28 @@ typedef struct
 ** \camtlm CAM Experiment telemetry packet
 ** #CAM_EXP_TLM_MID
 */
+/*
+** Only the used part of data is sent, the packet length is
+** CAM_EXP_TLM_HDR_LNGTH plus size.
+** length is always the FIFO length read back for the capture the data came
+** from, a burst shares one FIFO so every frame of it reports the same value.
+** frame_length is the bytes of the frame once its end of image is known,
+** the debug read path publishes before it finds the end and reports 0.
+*/
 typedef struct
 {
     CFE_MSG_TelemetryHeader_t TlmHeader;
+    uint16                    frame; /* Frame of a burst the data belongs to */
+    uint16                    size;  /* Bytes of data in this packet */
+    uint32                    msg_count;    /* Packets published for this frame, from 1 */
+    uint32                    length;       /* FIFO length of the capture */
+    uint32                    frame_length; /* Bytes of the frame, 0 when not yet known */
     uint8                     data[CAM_DATA_SIZE];
-    uint16                    spare;
-    uint32                    msg_count;
-    uint32                    length;
 
 } CAM_Exp_tlm_t;
-#define CAM_EXP_TLM_LNGTH sizeof(CAM_Exp_tlm_t)
+#define CAM_EXP_TLM_LNGTH     sizeof(CAM_Exp_tlm_t)
+#define CAM_EXP_TLM_HDR_LNGTH offsetof(CAM_Exp_tlm_t, data)
+
+CompileTimeAssert(CAM_EXP_TLM_LNGTH <= CFE_MISSION_SB_MAX_SB_MSG_SIZE, CamExpTlmExceedsSbMaxMsgSize);
 
 #endif
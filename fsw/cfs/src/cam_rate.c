@@ -0,0 +1,95 @@
+/* Copyright (C) 2009 - 2017 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S.
+Government.
+
+This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including,
+but not limited to, any warranty that the software will conform to, specifications any implied warranties of
+merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+documentation will conform to the program, or any warranty that the software will be error free.
+
+In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+consequential damages, arising out of, resulting from, or in any way connected with the software or its documentation.
+Whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained from, or arose
+out of the results of, or use of, the software, documentation or services provided hereunder
+
+ITC Team
+NASA IV&V
+ivv-itc@lists.nasa.gov
+*/
+
+#include "cam_app.h"
+
+/*
+**  Name:  CAM_rate_set
+**
+**  Purpose:
+** 		   Change the downlink budget, the bucket starts full.
+*/
+void CAM_rate_set(uint32 rate, uint32 burst)
+{
+    OS_MutSemTake(CAM_AppData.data_mutex);
+    CAM_AppData.Rate.Rate   = rate;
+    CAM_AppData.Rate.Burst  = burst;
+    CAM_AppData.Rate.Tokens = (uint64)burst * CAM_RATE_SCALE;
+    OS_GetLocalTime(&CAM_AppData.Rate.Last);
+    OS_MutSemGive(CAM_AppData.data_mutex);
+} /* End of CAM_rate_set() */
+
+/*
+**  Name:  CAM_rate_wait
+**
+**  Purpose:
+** 		   Block until bytes may be sent without exceeding the rate.
+**         Returns right away when unthrottled.
+*/
+void CAM_rate_wait(uint32 bytes)
+{
+    OS_time_t now;
+    int64     elapsed;
+    uint64    need;
+    uint64    full;
+    uint32    delay = 0;
+
+    do
+    {
+        if (delay > 0)
+        {
+            OS_TaskDelay(delay);
+        }
+
+        OS_MutSemTake(CAM_AppData.data_mutex);
+        delay = 0;
+        if (CAM_AppData.Rate.Rate > 0)
+        {
+            // Refill for the time since the last check, up to a full bucket
+            OS_GetLocalTime(&now);
+            elapsed = OS_TimeGetTotalMicroseconds(OS_TimeSubtract(now, CAM_AppData.Rate.Last));
+            CAM_AppData.Rate.Last = now;
+            if (elapsed > 0)
+            {
+                CAM_AppData.Rate.Tokens += (uint64)elapsed * CAM_AppData.Rate.Rate;
+            }
+            full = (uint64)CAM_AppData.Rate.Burst * CAM_RATE_SCALE;
+            if (CAM_AppData.Rate.Tokens > full)
+            {
+                CAM_AppData.Rate.Tokens = full;
+            }
+
+            // Anything bigger than the bucket waits for a full bucket
+            need = (uint64)bytes * CAM_RATE_SCALE;
+            if (need > full)
+            {
+                need = full;
+            }
+
+            if (CAM_AppData.Rate.Tokens >= need)
+            {
+                CAM_AppData.Rate.Tokens -= need;
+            }
+            else
+            {
+                delay = (uint32)((need - CAM_AppData.Rate.Tokens) / CAM_AppData.Rate.Rate / 1000) + 1;
+            }
+        }
+        OS_MutSemGive(CAM_AppData.data_mutex);
+    } while (delay > 0);
+} /* End of CAM_rate_wait() */
@@ -1,28 +1,41 @@
-/* Copyright (C) 2009 - 2017 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S.
-Government.
-
-This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including,
-but not limited to, any warranty that the software will conform to, specifications any implied warranties of
-merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
-documentation will conform to the program, or any warranty that the software will be error free.
-
-In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
-consequential damages, arising out of, resulting from, or in any way connected with the software or its documentation.
-Whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained from, or arose
-out of the results of, or use of, the software, documentation or services provided hereunder
-
-ITC Team
-NASA IV&V
-ivv-itc@lists.nasa.gov
-*/
-
-#ifndef _CAM_PERFIDS_H_
-#define _CAM_PERFIDS_H_
-
-/*
-** CAM performance IDs
-*/
-#define CAM_PERF_ID            105
-#define CAM_CHILD_TASK_PERF_ID 106
-
-#endif
+/* Copyright (C) 2009 - 2017 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S.
+Government.
+
+This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including,
+but not limited to, any warranty that the software will conform to, specifications any implied warranties of
+merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+documentation will conform to the program, or any warranty that the software will be error free.
+
+In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+consequential damages, arising out of, resulting from, or in any way connected with the software or its documentation.
+Whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained from, or arose
+out of the results of, or use of, the software, documentation or services provided hereunder
+
+ITC Team
+NASA IV&V
+ivv-itc@lists.nasa.gov
+*/
+
+#ifndef _cam_rate_h_
+#define _cam_rate_h_
+
+#include "cfe.h"
+
+/*
+** Token bucket pacing experiment telemetry to the downlink budget
+*/
+typedef struct
+{
+    uint32    Rate;   /* Bytes per second, 0 is unthrottled */
+    uint32    Burst;  /* Bytes that may go out back to back */
+    uint64    Tokens; /* Bytes available, scaled by CAM_RATE_SCALE */
+    OS_time_t Last;   /* Time tokens were last added */
+} CAM_Rate_t;
+
+/* Tokens are kept in bytes per microsecond of elapsed time */
+#define CAM_RATE_SCALE 1000000
+
+void CAM_rate_set(uint32 rate, uint32 burst);
+void CAM_rate_wait(uint32 bytes);
+
+#endif /* _cam_rate_h_ */
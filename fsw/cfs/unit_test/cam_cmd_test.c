@@ -28,6 +28,7 @@
 #include <utassert.h>
 #include <ut_cfe_sb_hooks.h>
 #include <ut_cfe_sb_stubs.h>
+#include <ut_osapi_stubs.h>
 
 #include <stdio.h>
 
@@ -58,6 +59,8 @@ static void CAM_Cmd_Test_RESET_COUNTERS(void)
     /* init data */
     CAM_AppData.HkTelemetryPkt.CommandCount      = 10;
     CAM_AppData.HkTelemetryPkt.CommandErrorCount = 20;
+    CAM_Stats.i2c_errors                         = 3;
+    CAM_Stats.frames                             = 4;
 
     /* init reset counters cmd */
     CAM_NoArgsCmd_t cmd;
@@ -71,6 +74,10 @@ static void CAM_Cmd_Test_RESET_COUNTERS(void)
     /* cmd counters */
     UtAssert_True(CAM_AppData.HkTelemetryPkt.CommandCount == 0, "cam cmd count");
     UtAssert_True(CAM_AppData.HkTelemetryPkt.CommandErrorCount == 0, "cam cmd error count");
+
+    /* capture counters */
+    UtAssert_True(CAM_Stats.i2c_errors == 0, "cam i2c errors");
+    UtAssert_True(CAM_Stats.frames == 0, "cam frames");
 }
 
 /* test stop cmd */
@@ -179,6 +186,7 @@ static void CAM_Cmd_Test_LOW_VOLTAGE(void)
     CAM_AppData.HkTelemetryPkt.CommandCount      = 10;
     CAM_AppData.HkTelemetryPkt.CommandErrorCount = 20;
     CAM_AppData.State                            = CAM_RUN;
+    CAM_AppData.Reinit                           = 0;
 
     /* init timeout cmd */
     CAM_NoArgsCmd_t cmd;
@@ -195,6 +203,7 @@ static void CAM_Cmd_Test_LOW_VOLTAGE(void)
 
     /* app data */
     UtAssert_True(CAM_AppData.State == CAM_LOW_VOLTAGE, "cam low voltage");
+    UtAssert_True(CAM_AppData.Reinit == 1, "cam session invalidated");
 }
 
 /* test exp 1 cmd */
@@ -275,6 +284,171 @@ static void CAM_Cmd_Test_EXP3(void)
     UtAssert_True(CAM_AppData.State == CAM_TIME, "cam time");
 }
 
+/* test burst cmd */
+static void CAM_Cmd_Test_BURST(void)
+{
+    /* init data */
+    CAM_AppData.HkTelemetryPkt.CommandCount      = 10;
+    CAM_AppData.HkTelemetryPkt.CommandErrorCount = 20;
+    CAM_AppData.State                            = CAM_STOP;
+
+    /* init burst cmd */
+    CAM_BurstCmd_t cmd;
+    Ut_CFE_MSG_InitHook(&cmd, CAM_CMD_MID, sizeof(CAM_BurstCmd_t), true);
+    Ut_CFE_SB_SetCmdCodeHook((CFE_MSG_Message_t *)&cmd, CAM_BURST_CC);
+    cmd.Exp    = 2;
+    cmd.Frames = 4;
+
+    /* process cmd */
+    CAM_AppData.MsgPtr = (CFE_MSG_Message_t *)&cmd;
+    CAM_ProcessCommandPacket();
+
+    /* cmd counters */
+    UtAssert_True(CAM_AppData.HkTelemetryPkt.CommandCount == 11, "cam cmd count");
+    UtAssert_True(CAM_AppData.HkTelemetryPkt.CommandErrorCount == 20, "cam cmd error count");
+
+    /* app data */
+    UtAssert_True(CAM_AppData.Exp == 2, "cam burst exp 2");
+    UtAssert_True(CAM_AppData.Frames == 4, "cam burst frames");
+}
+
+/* test burst cmd with too many frames */
+static void CAM_Cmd_Test_BURST_INVALID(void)
+{
+    /* init data */
+    CAM_AppData.HkTelemetryPkt.CommandCount      = 10;
+    CAM_AppData.HkTelemetryPkt.CommandErrorCount = 20;
+    CAM_AppData.Frames                           = 1;
+
+    /* init burst cmd */
+    CAM_BurstCmd_t cmd;
+    Ut_CFE_MSG_InitHook(&cmd, CAM_CMD_MID, sizeof(CAM_BurstCmd_t), true);
+    Ut_CFE_SB_SetCmdCodeHook((CFE_MSG_Message_t *)&cmd, CAM_BURST_CC);
+    cmd.Exp    = 1;
+    cmd.Frames = CAM_BURST_MAX_FRAMES + 1;
+
+    /* process cmd */
+    CAM_AppData.MsgPtr = (CFE_MSG_Message_t *)&cmd;
+    CAM_ProcessCommandPacket();
+
+    /* cmd counters */
+    UtAssert_True(CAM_AppData.HkTelemetryPkt.CommandCount == 10, "cam cmd count");
+    UtAssert_True(CAM_AppData.HkTelemetryPkt.CommandErrorCount == 21, "cam cmd error count");
+
+    /* app data */
+    UtAssert_True(CAM_AppData.Frames == 1, "cam burst frames unchanged");
+}
+
+/* test set rate cmd */
+static void CAM_Cmd_Test_SET_RATE(void)
+{
+    /* init data */
+    CAM_AppData.HkTelemetryPkt.CommandCount      = 10;
+    CAM_AppData.HkTelemetryPkt.CommandErrorCount = 20;
+
+    /* init set rate cmd */
+    CAM_RateCmd_t cmd;
+    Ut_CFE_MSG_InitHook(&cmd, CAM_CMD_MID, sizeof(CAM_RateCmd_t), true);
+    Ut_CFE_SB_SetCmdCodeHook((CFE_MSG_Message_t *)&cmd, CAM_SET_RATE_CC);
+    cmd.Rate  = 8192;
+    cmd.Burst = 2048;
+
+    /* process cmd */
+    CAM_AppData.MsgPtr = (CFE_MSG_Message_t *)&cmd;
+    CAM_ProcessCommandPacket();
+
+    /* cmd counters */
+    UtAssert_True(CAM_AppData.HkTelemetryPkt.CommandCount == 11, "cam cmd count");
+    UtAssert_True(CAM_AppData.HkTelemetryPkt.CommandErrorCount == 20, "cam cmd error count");
+
+    /* app data */
+    UtAssert_True(CAM_AppData.Rate.Rate == 8192, "cam rate");
+    UtAssert_True(CAM_AppData.Rate.Burst == 2048, "cam rate burst");
+}
+
+/* test set rate cmd with an empty bucket */
+static void CAM_Cmd_Test_SET_RATE_INVALID(void)
+{
+    /* init data */
+    CAM_AppData.HkTelemetryPkt.CommandCount      = 10;
+    CAM_AppData.HkTelemetryPkt.CommandErrorCount = 20;
+    CAM_AppData.Rate.Rate                        = 4096;
+    CAM_AppData.Rate.Burst                       = 4096;
+
+    /* init set rate cmd */
+    CAM_RateCmd_t cmd;
+    Ut_CFE_MSG_InitHook(&cmd, CAM_CMD_MID, sizeof(CAM_RateCmd_t), true);
+    Ut_CFE_SB_SetCmdCodeHook((CFE_MSG_Message_t *)&cmd, CAM_SET_RATE_CC);
+    cmd.Rate  = 8192;
+    cmd.Burst = 0;
+
+    /* process cmd */
+    CAM_AppData.MsgPtr = (CFE_MSG_Message_t *)&cmd;
+    CAM_ProcessCommandPacket();
+
+    /* cmd counters */
+    UtAssert_True(CAM_AppData.HkTelemetryPkt.CommandCount == 10, "cam cmd count");
+    UtAssert_True(CAM_AppData.HkTelemetryPkt.CommandErrorCount == 21, "cam cmd error count");
+
+    /* app data */
+    UtAssert_True(CAM_AppData.Rate.Rate == 4096, "cam rate unchanged");
+    UtAssert_True(CAM_AppData.Rate.Burst == 4096, "cam rate burst unchanged");
+}
+
+/* test set data size cmd */
+static void CAM_Cmd_Test_SET_DATA_SIZE(void)
+{
+    /* init data */
+    CAM_AppData.HkTelemetryPkt.CommandCount      = 10;
+    CAM_AppData.HkTelemetryPkt.CommandErrorCount = 20;
+    CAM_AppData.State                            = CAM_STOP;
+    CAM_AppData.DataSize                         = CAM_DATA_SIZE;
+
+    /* init set data size cmd */
+    CAM_DataSizeCmd_t cmd;
+    Ut_CFE_MSG_InitHook(&cmd, CAM_CMD_MID, sizeof(CAM_DataSizeCmd_t), true);
+    Ut_CFE_SB_SetCmdCodeHook((CFE_MSG_Message_t *)&cmd, CAM_SET_DATA_SIZE_CC);
+    cmd.DataSize = 512;
+
+    /* process cmd */
+    CAM_AppData.MsgPtr = (CFE_MSG_Message_t *)&cmd;
+    CAM_ProcessCommandPacket();
+
+    /* cmd counters */
+    UtAssert_True(CAM_AppData.HkTelemetryPkt.CommandCount == 11, "cam cmd count");
+    UtAssert_True(CAM_AppData.HkTelemetryPkt.CommandErrorCount == 20, "cam cmd error count");
+
+    /* app data */
+    UtAssert_True(CAM_AppData.DataSize == 512, "cam data size");
+}
+
+/* test set data size cmd larger than the packet */
+static void CAM_Cmd_Test_SET_DATA_SIZE_INVALID(void)
+{
+    /* init data */
+    CAM_AppData.HkTelemetryPkt.CommandCount      = 10;
+    CAM_AppData.HkTelemetryPkt.CommandErrorCount = 20;
+    CAM_AppData.State                            = CAM_STOP;
+    CAM_AppData.DataSize                         = CAM_DATA_SIZE;
+
+    /* init set data size cmd */
+    CAM_DataSizeCmd_t cmd;
+    Ut_CFE_MSG_InitHook(&cmd, CAM_CMD_MID, sizeof(CAM_DataSizeCmd_t), true);
+    Ut_CFE_SB_SetCmdCodeHook((CFE_MSG_Message_t *)&cmd, CAM_SET_DATA_SIZE_CC);
+    cmd.DataSize = CAM_DATA_SIZE + 1;
+
+    /* process cmd */
+    CAM_AppData.MsgPtr = (CFE_MSG_Message_t *)&cmd;
+    CAM_ProcessCommandPacket();
+
+    /* cmd counters */
+    UtAssert_True(CAM_AppData.HkTelemetryPkt.CommandCount == 10, "cam cmd count");
+    UtAssert_True(CAM_AppData.HkTelemetryPkt.CommandErrorCount == 21, "cam cmd error count");
+
+    /* app data */
+    UtAssert_True(CAM_AppData.DataSize == CAM_DATA_SIZE, "cam data size unchanged");
+}
+
 /* test send HkTelemetryPkt cmd */
 static void CAM_Cmd_Test_HK(void)
 {
@@ -283,6 +457,13 @@ static void CAM_Cmd_Test_HK(void)
     CAM_AppData.HkTelemetryPkt.CommandCount      = 10;
     CAM_AppData.HkTelemetryPkt.CommandErrorCount = 20;
 
+    /* image downlinked in 200 byte packets, data size changed since */
+    CAM_AppData.State     = CAM_RUN;
+    CAM_AppData.Length    = 1000;
+    CAM_AppData.MsgCount  = 3;
+    CAM_AppData.ImageSize = 200;
+    CAM_AppData.DataSize  = 64;
+
     /* init HkTelemetryPkt cmd */
     CAM_NoArgsCmd_t cmd;
     Ut_CFE_MSG_InitHook(&cmd, CAM_SEND_HK_MID, sizeof(CAM_NoArgsCmd_t), true);
@@ -303,7 +484,230 @@ static void CAM_Cmd_Test_HK(void)
     {
         UtAssert_True(HkTelemetryPkt->CommandCount == 10, "cam HkTelemetryPkt cmd error count");
         UtAssert_True(HkTelemetryPkt->CommandErrorCount == 20, "cam HkTelemetryPkt cmd error count");
+        UtAssert_True(HkTelemetryPkt->Backlog == 400, "cam HkTelemetryPkt backlog");
+        UtAssert_True(HkTelemetryPkt->DataSize == 64, "cam HkTelemetryPkt data size");
     }
+
+    /* short last packet out, nothing left */
+    CAM_AppData.MsgCount = 5;
+    CAM_AppData.Length   = 950;
+    CAM_ProcessCommandPacket();
+    HkTelemetryPkt = (CAM_Hk_tlm_t *)Ut_CFE_SB_FindPacket(CAM_HK_TLM_MID, 2);
+    UtAssert_True((HkTelemetryPkt != NULL) && (HkTelemetryPkt->Backlog == 0), "cam HkTelemetryPkt no backlog");
+}
+
+/* images the capture stage queued for downlink */
+#define CAM_TEST_IMAGES     2
+#define CAM_TEST_IMAGE_SIZE 256
+static CAM_Image_t CAM_Test_Image[CAM_TEST_IMAGES];
+static uint8       CAM_Test_Image_Data[CAM_TEST_IMAGES][CAM_TEST_IMAGE_SIZE];
+static uint8       CAM_Test_Images;
+static uint8       CAM_Test_Slots;
+static uint8       CAM_Test_Slot[CAM_TEST_IMAGE_SIZE + CAM_DATA_SIZE];
+
+/* free slot queue hook, every staged image reuses the one test slot */
+static int32 CAM_Test_QueueGet(uint32 queue_id, void *data, uint32 size, uint32 *size_copied, int32 timeout)
+{
+    uint8 *slot = CAM_Test_Slot;
+
+    CAM_Test_Slots++;
+    memcpy(data, &slot, sizeof(slot));
+    *size_copied = sizeof(slot);
+    return OS_SUCCESS;
+}
+
+/* image queue hook, keeps a copy of each staged image */
+static int32 CAM_Test_QueuePut(uint32 queue_id, const void *data, uint32 size, uint32 flags)
+{
+    CAM_Image_t image;
+
+    if ((size != sizeof(CAM_Image_t)) || (CAM_Test_Images >= CAM_TEST_IMAGES))
+        return OS_SUCCESS;
+
+    memcpy(&image, data, sizeof(image));
+    UtAssert_True(image.length <= CAM_TEST_IMAGE_SIZE, "cam staged image fits");
+    memcpy(CAM_Test_Image_Data[CAM_Test_Images], image.data,
+           (image.length < CAM_TEST_IMAGE_SIZE) ? image.length : CAM_TEST_IMAGE_SIZE);
+
+    image.data                      = CAM_Test_Image_Data[CAM_Test_Images];
+    CAM_Test_Image[CAM_Test_Images] = image;
+    CAM_Test_Images++;
+    return OS_SUCCESS;
+}
+
+/* build a minimal JPEG, SOI then an empty scan header, scan bytes and EOI */
+static uint16 CAM_Test_Jpeg(uint8 *buf, uint16 scan)
+{
+    uint16 i = 0;
+
+    buf[i++] = 0xFF;
+    buf[i++] = CAM_JPEG_SOI;
+    buf[i++] = 0xFF;
+    buf[i++] = CAM_JPEG_SOS;
+    buf[i++] = 0x00;
+    buf[i++] = 0x02;
+    memset(&buf[i], 0x11, scan);
+    i += scan;
+    buf[i++] = 0xFF;
+    buf[i++] = CAM_JPEG_EOI;
+    return i;
+}
+
+/* drain one frame into the staging slab a packet at a time */
+static void CAM_Test_Drain(uint8 frame, char **buf, const uint8 *data, uint16 length)
+{
+    uint16 offset = 0;
+    uint16 piece;
+
+    while (offset < length)
+    {
+        piece = ((length - offset) < CAM_AppData.DataSize) ? (length - offset) : CAM_AppData.DataSize;
+        UtAssert_True(*buf != NULL, "cam staging slab");
+        if (*buf == NULL)
+            return;
+        memcpy(*buf, &data[offset], piece);
+        offset += piece;
+        CAM_stage_sink(frame, buf, piece, (offset == length) ? 1 : 0);
+    }
+}
+
+/* test a burst is staged frame by frame, split at each end of image */
+static void CAM_Cmd_Test_BURST_STAGE(void)
+{
+    uint8  burst[2][CAM_TEST_IMAGE_SIZE];
+    uint16 length[2];
+    char  *buf = NULL;
+
+    /* init data */
+    CAM_AppData.State    = CAM_RUN;
+    CAM_AppData.DataSize = 64;
+    CAM_Test_Images      = 0;
+    CAM_Test_Slots       = 0;
+    Ut_OSAPI_SetFunctionHook(UT_OSAPI_QUEUEGET_INDEX, (void *)&CAM_Test_QueueGet);
+    Ut_OSAPI_SetFunctionHook(UT_OSAPI_QUEUEPUT_INDEX, (void *)&CAM_Test_QueuePut);
+
+    /* two frames, the last one has FIFO padding behind its end of image */
+    length[0] = CAM_Test_Jpeg(burst[0], 150);
+    length[1] = CAM_Test_Jpeg(burst[1], 70);
+    memset(&burst[1][length[1]], 0x00, 10);
+    CAM_Stats.fifo_length = length[0] + length[1] + 10;
+
+    /* drain */
+    UtAssert_True(CAM_stage_first(&buf, 2, 64) == OS_SUCCESS, "cam stage first frame");
+    CAM_Test_Drain(0, &buf, burst[0], length[0]);
+    CAM_Test_Drain(1, &buf, burst[1], length[1] + 10);
+
+    /* staged images */
+    UtAssert_True(CAM_Test_Images == 2, "cam burst frames staged");
+    UtAssert_True(CAM_AppData.Staged == 2, "cam burst frames queued");
+    UtAssert_True(CAM_Test_Slots == 2, "cam no slot taken after the last frame");
+    UtAssert_True(buf == NULL, "cam nothing staged after the last frame");
+    UtAssert_True(CAM_AppData.HkTelemetryPkt.PoolHighWater == 2, "cam staging slot high water");
+    if (CAM_Test_Images == 2)
+    {
+        UtAssert_True(CAM_Test_Image[0].frame == 0, "cam frame 1 number");
+        UtAssert_True(CAM_Test_Image[0].length == length[0], "cam frame 1 length");
+        UtAssert_True(CAM_Test_Image[1].frame == 1, "cam frame 2 number");
+        UtAssert_True(CAM_Test_Image[1].length == length[1], "cam frame 2 trimmed at end of image");
+        UtAssert_True(CAM_Test_Image[1].fifo_length == CAM_Stats.fifo_length, "cam frame 2 fifo length");
+        UtAssert_True(memcmp(CAM_Test_Image[0].data, burst[0], length[0]) == 0, "cam frame 1 data");
+        UtAssert_True(memcmp(CAM_Test_Image[1].data, burst[1], length[1]) == 0, "cam frame 2 data");
+    }
+}
+
+/* test a reset counters cmd during a capture is left to the child task */
+static void CAM_Cmd_Test_BURST_RESET_COUNTERS(void)
+{
+    uint8  frame[CAM_TEST_IMAGE_SIZE];
+    uint16 length;
+    char  *buf = NULL;
+
+    /* init data */
+    CAM_AppData.State     = CAM_RUN;
+    CAM_AppData.Capturing = 1;
+    CAM_AppData.DataSize  = 64;
+    CAM_Stats.i2c_errors  = 3;
+    CAM_Stats.frames      = 4;
+    CAM_Test_Images       = 0;
+    CAM_Test_Slots        = 0;
+    Ut_OSAPI_SetFunctionHook(UT_OSAPI_QUEUEGET_INDEX, (void *)&CAM_Test_QueueGet);
+    Ut_OSAPI_SetFunctionHook(UT_OSAPI_QUEUEPUT_INDEX, (void *)&CAM_Test_QueuePut);
+
+    /* init reset counters cmd */
+    CAM_NoArgsCmd_t cmd;
+    Ut_CFE_MSG_InitHook(&cmd, CAM_CMD_MID, sizeof(CAM_NoArgsCmd_t), true);
+    Ut_CFE_SB_SetCmdCodeHook((CFE_MSG_Message_t *)&cmd, CAM_RESET_COUNTERS_CC);
+
+    /* process cmd, the driver still owns the counters */
+    CAM_AppData.MsgPtr = (CFE_MSG_Message_t *)&cmd;
+    CAM_ProcessCommandPacket();
+    UtAssert_True(CAM_AppData.StatsReset == 1, "cam stats reset pending");
+    UtAssert_True(CAM_Stats.i2c_errors == 3, "cam i2c errors left to the child");
+    UtAssert_True(CAM_Stats.frames == 4, "cam frames left to the child");
+
+    /* the child clears them once the frame is staged */
+    length = CAM_Test_Jpeg(frame, 100);
+    UtAssert_True(CAM_stage_first(&buf, 1, 64) == OS_SUCCESS, "cam stage first frame");
+    CAM_Test_Drain(0, &buf, frame, length);
+    UtAssert_True(CAM_Test_Images == 1, "cam frame staged");
+    UtAssert_True(CAM_AppData.StatsReset == 0, "cam stats reset done");
+    UtAssert_True(CAM_Stats.i2c_errors == 0, "cam i2c errors");
+    UtAssert_True(CAM_Stats.frames == 0, "cam frames");
+}
+
+/* test each staged frame is published on its own, SOI first and EOI last */
+static void CAM_Cmd_Test_BURST_DOWNLINK(void)
+{
+    uint8          burst[2][CAM_TEST_IMAGE_SIZE];
+    CAM_Image_t    image[2];
+    uint16         sizes[5]  = {64, 64, 30, 64, 14};
+    uint8          frames[5] = {0, 0, 0, 1, 1};
+    uint8          counts[5] = {1, 2, 3, 1, 2};
+    CAM_Exp_tlm_t *pkt;
+    uint8          n;
+
+    /* init data, a data size commanded after the capture does not apply */
+    CAM_AppData.State    = CAM_RUN;
+    CAM_AppData.DataSize = CAM_DATA_SIZE;
+    memset(image, 0, sizeof(image));
+    image[0].data        = burst[0];
+    image[0].length      = CAM_Test_Jpeg(burst[0], 150);
+    image[0].frame       = 0;
+    image[1].data        = burst[1];
+    image[1].length      = CAM_Test_Jpeg(burst[1], 70);
+    image[1].frame       = 1;
+    image[0].fifo_length = image[0].length + image[1].length + 10;
+    image[1].fifo_length = image[0].fifo_length;
+    image[0].data_size   = 64;
+    image[1].data_size   = 64;
+
+    /* publish */
+    UtAssert_True(CAM_downlink(&image[0]) == OS_SUCCESS, "cam frame 1 published");
+    UtAssert_True(CAM_downlink(&image[1]) == OS_SUCCESS, "cam frame 2 published");
+
+    /* experiment packets */
+    for (n = 0; n < 5; n++)
+    {
+        pkt = (CAM_Exp_tlm_t *)Ut_CFE_SB_FindPacket(CAM_EXP_TLM_MID, n + 1);
+        UtAssert_True(pkt != NULL, "cam experiment packet");
+        if (pkt == NULL)
+            continue;
+        UtAssert_True(pkt->frame == frames[n], "cam packet frame");
+        UtAssert_True(pkt->msg_count == counts[n], "cam packet msg_count restarts each frame");
+        UtAssert_True(pkt->size == sizes[n], "cam packet size");
+        UtAssert_True(pkt->length == image[0].fifo_length, "cam packet fifo length");
+        UtAssert_True(pkt->frame_length == image[frames[n]].length, "cam packet frame length");
+        if (counts[n] == 1)
+        {
+            UtAssert_True((pkt->data[0] == 0xFF) && (pkt->data[1] == CAM_JPEG_SOI), "cam frame starts at SOI");
+        }
+        if ((n == 2) || (n == 4))
+        {
+            UtAssert_True((pkt->data[pkt->size - 2] == 0xFF) && (pkt->data[pkt->size - 1] == CAM_JPEG_EOI),
+                          "cam frame ends at EOI");
+        }
+    }
+    UtAssert_True(CAM_AppData.HkTelemetryPkt.PacketsSent == 2, "cam packets sent for last frame");
 }
 
 /* test invalid cmd code */
@@ -397,6 +801,25 @@ void CAM_Cmd_Test_AddTestCases(void)
 
     UtTest_Add(CAM_Cmd_Test_EXP3, CAM_Test_Setup, CAM_Test_TearDown, "Cam Ground Command: EXP 3");
 
+    UtTest_Add(CAM_Cmd_Test_BURST, CAM_Test_Setup, CAM_Test_TearDown, "Cam Ground Command: BURST");
+
+    UtTest_Add(CAM_Cmd_Test_BURST_INVALID, CAM_Test_Setup, CAM_Test_TearDown, "Cam Ground Command: BURST INVALID");
+
+    UtTest_Add(CAM_Cmd_Test_SET_RATE, CAM_Test_Setup, CAM_Test_TearDown, "Cam Ground Command: SET RATE");
+
+    UtTest_Add(CAM_Cmd_Test_SET_RATE_INVALID, CAM_Test_Setup, CAM_Test_TearDown, "Cam Ground Command: SET RATE INVALID");
+
+    UtTest_Add(CAM_Cmd_Test_SET_DATA_SIZE, CAM_Test_Setup, CAM_Test_TearDown, "Cam Ground Command: SET DATA SIZE");
+
+    UtTest_Add(CAM_Cmd_Test_SET_DATA_SIZE_INVALID, CAM_Test_Setup, CAM_Test_TearDown,
+               "Cam Ground Command: SET DATA SIZE INVALID");
+
+    UtTest_Add(CAM_Cmd_Test_BURST_STAGE, CAM_Test_Setup, CAM_Test_TearDown, "Cam Burst: STAGE");
+
+    UtTest_Add(CAM_Cmd_Test_BURST_RESET_COUNTERS, CAM_Test_Setup, CAM_Test_TearDown, "Cam Burst: RESET COUNTERS");
+
+    UtTest_Add(CAM_Cmd_Test_BURST_DOWNLINK, CAM_Test_Setup, CAM_Test_TearDown, "Cam Burst: DOWNLINK");
+
     UtTest_Add(CAM_Cmd_Test_INVALID_CC, CAM_Test_Setup, CAM_Test_TearDown, "Cam Ground Command: INVALID CMD CODE");
 
     UtTest_Add(CAM_Cmd_Test_INVALID_MSG, CAM_Test_Setup, CAM_Test_TearDown, "Cam Ground Command: INVALID MSG");
@@ -0,0 +1,304 @@
+/* Copyright (C) 2009 - 2017 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S.
+Government.
+
+This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including,
+but not limited to, any warranty that the software will conform to, specifications any implied warranties of
+merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+documentation will conform to the program, or any warranty that the software will be error free.
+
+In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+consequential damages, arising out of, resulting from, or in any way connected with the software or its documentation.
+Whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained from, or arose
+out of the results of, or use of, the software, documentation or services provided hereunder
+
+ITC Team
+NASA IV&V
+ivv-itc@lists.nasa.gov
+*/
+
+/*******************************************************************************
+** File: cam_bus.c
+**
+** Purpose:
+**   Records the driver's hwlib calls to a trace, or replays a trace in their place.
+**
+*******************************************************************************/
+
+/*************************************************************************
+** Includes
+*************************************************************************/
+#define CAM_BUS_IMPL
+#include "device_cfg.h"
+#include "cam_bus.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*************************************************************************
+** Private Data
+*************************************************************************/
+static FILE           *CAM_Bus_File;   // Trace being recorded
+static uint8_t        *CAM_Bus_Trace;  // Trace being replayed
+static uint32_t        CAM_Bus_Length;
+static uint32_t        CAM_Bus_Pos;
+static struct timespec CAM_Bus_Start;
+static CAM_Bus_Stats_t CAM_Bus_Stats;
+
+/*
+** The real call is only made when not replaying, so a replay build needs no hwlib
+*/
+#ifdef CAM_BUS_REPLAY
+#define CAM_BUS_CALL(op, out, out_len, in, in_len, call) CAM_bus_serve(op, out, out_len, in, in_len)
+#else
+#define CAM_BUS_CALL(op, out, out_len, in, in_len, call) CAM_bus_log(op, out, out_len, in, in_len, call)
+#endif
+
+#ifndef CAM_BUS_REPLAY
+static void CAM_bus_put16(uint8_t *p, uint16_t value)
+{
+    p[0] = value & 0xFF;
+    p[1] = value >> 8;
+}
+
+static void CAM_bus_put32(uint8_t *p, uint32_t value)
+{
+    CAM_bus_put16(p, value & 0xFFFF);
+    CAM_bus_put16(&p[2], value >> 16);
+}
+
+static uint32_t CAM_bus_time_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)(((now.tv_sec - CAM_Bus_Start.tv_sec) * 1000000) + ((now.tv_nsec - CAM_Bus_Start.tv_nsec) / 1000));
+}
+#else
+static uint16_t CAM_bus_get16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+#endif
+
+static void CAM_bus_count(uint32_t out_len, uint32_t in_len)
+{
+    CAM_Bus_Stats.calls++;
+    CAM_Bus_Stats.bytes_out += out_len;
+    CAM_Bus_Stats.bytes_in += in_len;
+}
+
+#ifndef CAM_BUS_REPLAY
+static int32_t CAM_bus_log(uint8_t op, const void *out, uint32_t out_len, const void *in, uint32_t in_len, int32_t status)
+{
+    uint8_t record[CAM_BUS_RECORD_SIZE];
+
+    CAM_bus_count(out_len, in_len);
+    if (CAM_Bus_File != NULL)
+    {
+        // Transfers from the driver are chunked well under this
+        out_len = (out_len > 0xFFFF) ? 0xFFFF : out_len;
+        in_len  = (in_len > 0xFFFF) ? 0xFFFF : in_len;
+
+        CAM_bus_put32(&record[0], CAM_bus_time_us());
+        record[4] = op;
+        record[5] = (status == OS_SUCCESS) ? 0 : 1;
+        CAM_bus_put16(&record[6], out_len);
+        CAM_bus_put16(&record[8], in_len);
+        fwrite(record, 1, sizeof(record), CAM_Bus_File);
+        if (out_len > 0)
+        {
+            fwrite(out, 1, out_len, CAM_Bus_File);
+        }
+        if (in_len > 0)
+        {
+            fwrite(in, 1, in_len, CAM_Bus_File);
+        }
+    }
+    return status;
+}
+#else
+static int32_t CAM_bus_serve(uint8_t op, const void *out, uint32_t out_len, void *in, uint32_t in_len)
+{
+    const uint8_t *record = &CAM_Bus_Trace[CAM_Bus_Pos];
+    uint16_t       rec_out;
+    uint16_t       rec_in;
+
+    CAM_bus_count(out_len, in_len);
+    if (in_len > 0)
+    {
+        memset(in, 0, in_len);
+    }
+    if ((CAM_Bus_Trace == NULL) || ((CAM_Bus_Pos + CAM_BUS_RECORD_SIZE) > CAM_Bus_Length))
+    {
+        CAM_Bus_Stats.mismatches++;
+        return OS_ERROR;
+    }
+    rec_out = CAM_bus_get16(&record[6]);
+    rec_in  = CAM_bus_get16(&record[8]);
+    if ((CAM_Bus_Pos + CAM_BUS_RECORD_SIZE + rec_out + rec_in) > CAM_Bus_Length)
+    {
+        CAM_Bus_Pos = CAM_Bus_Length;
+        CAM_Bus_Stats.mismatches++;
+        return OS_ERROR;
+    }
+
+    // Anything the driver now does differently is counted, the trace still moves on
+    if ((record[4] != op) || (rec_out != out_len) ||
+        ((out_len > 0) && (memcmp(&record[CAM_BUS_RECORD_SIZE], out, out_len) != 0)))
+    {
+        if (CAM_Bus_Stats.mismatches++ == 0)
+        {
+            OS_printf("CAM_bus_serve: call %u differs from the trace\n", (unsigned)CAM_Bus_Stats.calls);
+        }
+    }
+    if ((in_len > 0) && (rec_in > 0))
+    {
+        memcpy(in, &record[CAM_BUS_RECORD_SIZE + rec_out], (rec_in < in_len) ? rec_in : in_len);
+    }
+    CAM_Bus_Pos += CAM_BUS_RECORD_SIZE + rec_out + rec_in;
+    return (record[5] == 0) ? OS_SUCCESS : OS_ERROR;
+}
+#endif
+
+/*******************************************************************************
+** Trace Control
+*******************************************************************************/
+int32_t CAM_bus_record(const char *path)
+{
+    uint8_t header[CAM_BUS_HEADER_SIZE] = {0};
+
+    CAM_bus_stop();
+    CAM_Bus_File = fopen(path, "wb");
+    if (CAM_Bus_File == NULL)
+    {
+        OS_printf("CAM_bus_record: could not create %s\n", path);
+        return OS_ERROR;
+    }
+
+    memcpy(header, CAM_BUS_TRACE_MAGIC, 4);
+    header[4] = CAM_BUS_TRACE_VERSION;
+#ifdef OV2640
+    header[5] = 1;
+#endif
+#ifdef OV5640
+    header[5] = 2;
+#endif
+#ifdef OV5642
+    header[5] = 3;
+#endif
+    fwrite(header, 1, sizeof(header), CAM_Bus_File);
+    clock_gettime(CLOCK_MONOTONIC, &CAM_Bus_Start);
+    CAM_bus_reset_stats();
+    return OS_SUCCESS;
+}
+
+int32_t CAM_bus_replay(const char *path)
+{
+    FILE *fp;
+    long  length;
+
+    CAM_bus_stop();
+    fp = fopen(path, "rb");
+    if (fp == NULL)
+    {
+        OS_printf("CAM_bus_replay: could not open %s\n", path);
+        return OS_ERROR;
+    }
+
+    // Whole trace in memory so replay does no file access
+    fseek(fp, 0, SEEK_END);
+    length = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (length >= CAM_BUS_HEADER_SIZE)
+    {
+        CAM_Bus_Trace = malloc(length);
+    }
+    if ((CAM_Bus_Trace == NULL) || (fread(CAM_Bus_Trace, 1, length, fp) != (size_t)length) ||
+        (memcmp(CAM_Bus_Trace, CAM_BUS_TRACE_MAGIC, 4) != 0) || (CAM_Bus_Trace[4] != CAM_BUS_TRACE_VERSION))
+    {
+        OS_printf("CAM_bus_replay: %s is not a bus trace\n", path);
+        fclose(fp);
+        CAM_bus_stop();
+        return OS_ERROR;
+    }
+    fclose(fp);
+
+    CAM_Bus_Length = length;
+    CAM_bus_rewind();
+    return OS_SUCCESS;
+}
+
+void CAM_bus_rewind(void)
+{
+    CAM_Bus_Pos = CAM_BUS_HEADER_SIZE;
+    CAM_bus_reset_stats();
+}
+
+void CAM_bus_stop(void)
+{
+    if (CAM_Bus_File != NULL)
+    {
+        fclose(CAM_Bus_File);
+        CAM_Bus_File = NULL;
+    }
+    free(CAM_Bus_Trace);
+    CAM_Bus_Trace  = NULL;
+    CAM_Bus_Length = 0;
+    CAM_Bus_Pos    = 0;
+}
+
+void CAM_bus_stats(CAM_Bus_Stats_t *stats)
+{
+    *stats = CAM_Bus_Stats;
+}
+
+void CAM_bus_reset_stats(void)
+{
+    memset(&CAM_Bus_Stats, 0, sizeof(CAM_Bus_Stats));
+}
+
+/*******************************************************************************
+** hwlib Calls
+*******************************************************************************/
+int32_t CAM_bus_i2c_init(i2c_bus_info_t *device)
+{
+    return CAM_BUS_CALL(CAM_BUS_OP_I2C_INIT, NULL, 0, NULL, 0, i2c_master_init(device));
+}
+
+int32_t CAM_bus_i2c_transaction(i2c_bus_info_t *device, uint8_t addr, void *txbuf, uint8_t txlen, void *rxbuf,
+                                uint8_t rxlen, uint16_t timeout)
+{
+    return CAM_BUS_CALL(CAM_BUS_OP_I2C, txbuf, txlen, rxbuf, rxlen,
+                        i2c_master_transaction(device, addr, txbuf, txlen, rxbuf, rxlen, timeout));
+}
+
+int32_t CAM_bus_spi_init(spi_info_t *device)
+{
+    return CAM_BUS_CALL(CAM_BUS_OP_SPI_INIT, NULL, 0, NULL, 0, spi_init_dev(device));
+}
+
+int32_t CAM_bus_spi_select(spi_info_t *device)
+{
+    return CAM_BUS_CALL(CAM_BUS_OP_SPI_SELECT, NULL, 0, NULL, 0, spi_select_chip(device));
+}
+
+int32_t CAM_bus_spi_unselect(spi_info_t *device)
+{
+    return CAM_BUS_CALL(CAM_BUS_OP_SPI_UNSELECT, NULL, 0, NULL, 0, spi_unselect_chip(device));
+}
+
+int32_t CAM_bus_spi_write(spi_info_t *device, uint8_t data[], const uint32_t numBytes)
+{
+    return CAM_BUS_CALL(CAM_BUS_OP_SPI_WRITE, data, numBytes, NULL, 0, spi_write(device, data, numBytes));
+}
+
+int32_t CAM_bus_spi_read(spi_info_t *device, uint8_t data[], const uint32_t numBytes)
+{
+    return CAM_BUS_CALL(CAM_BUS_OP_SPI_READ, NULL, 0, data, numBytes, spi_read(device, data, numBytes));
+}
+
+/************************/
+/*  End of File Comment */
+/************************/
@@ -0,0 +1,101 @@
+/* Copyright (C) 2009 - 2017 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S.
+Government.
+
+This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including,
+but not limited to, any warranty that the software will conform to, specifications any implied warranties of
+merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+documentation will conform to the program, or any warranty that the software will be error free.
+
+In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+consequential damages, arising out of, resulting from, or in any way connected with the software or its documentation.
+Whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained from, or arose
+out of the results of, or use of, the software, documentation or services provided hereunder
+
+ITC Team
+NASA IV&V
+ivv-itc@lists.nasa.gov
+*/
+
+#ifndef _cam_bus_h_
+#define _cam_bus_h_
+
+#include "hwlib.h"
+
+/************************************************************************
+** Bus Trace Definitions
+*************************************************************************/
+/*
+** Build with CAM_BUS_TRACE to route every hwlib call of the driver through
+** this layer so it can be recorded to a trace. Build with CAM_BUS_REPLAY
+** instead to serve a recorded trace back to the driver with no hwlib at all.
+**
+** Trace file: an 8 byte header ("CAMT", version, sensor, two reserved) then
+** one record per call, little endian:
+**   uint32 time_us  - since recording started
+**   uint8  op       - CAM_BUS_OP_*
+**   uint8  status   - 0 for OS_SUCCESS, 1 otherwise
+**   uint16 out_len  - bytes written, then the bytes
+**   uint16 in_len   - bytes read, then the bytes
+*/
+#define CAM_BUS_TRACE_MAGIC   "CAMT"
+#define CAM_BUS_TRACE_VERSION 1
+#define CAM_BUS_HEADER_SIZE   8
+#define CAM_BUS_RECORD_SIZE   10
+
+#define CAM_BUS_OP_I2C_INIT     1
+#define CAM_BUS_OP_I2C          2
+#define CAM_BUS_OP_SPI_INIT     3
+#define CAM_BUS_OP_SPI_SELECT   4
+#define CAM_BUS_OP_SPI_UNSELECT 5
+#define CAM_BUS_OP_SPI_WRITE    6
+#define CAM_BUS_OP_SPI_READ     7
+
+/*
+** Calls and bytes since the last record, replay or reset. On replay, mismatches
+** counts calls that differ from the trace in operation or bytes written.
+*/
+typedef struct
+{
+    uint32_t calls;
+    uint32_t bytes_out;
+    uint32_t bytes_in;
+    uint32_t mismatches;
+} CAM_Bus_Stats_t;
+
+/*************************************************************************
+** Exported Functions
+*************************************************************************/
+extern int32_t CAM_bus_record(const char *path);
+extern int32_t CAM_bus_replay(const char *path);
+extern void    CAM_bus_rewind(void);
+extern void    CAM_bus_stop(void);
+extern void    CAM_bus_stats(CAM_Bus_Stats_t *stats);
+extern void    CAM_bus_reset_stats(void);
+
+extern int32_t CAM_bus_i2c_init(i2c_bus_info_t *device);
+extern int32_t CAM_bus_i2c_transaction(i2c_bus_info_t *device, uint8_t addr, void *txbuf, uint8_t txlen, void *rxbuf,
+                                       uint8_t rxlen, uint16_t timeout);
+extern int32_t CAM_bus_spi_init(spi_info_t *device);
+extern int32_t CAM_bus_spi_select(spi_info_t *device);
+extern int32_t CAM_bus_spi_unselect(spi_info_t *device);
+extern int32_t CAM_bus_spi_write(spi_info_t *device, uint8_t data[], const uint32_t numBytes);
+extern int32_t CAM_bus_spi_read(spi_info_t *device, uint8_t data[], const uint32_t numBytes);
+
+/*
+** Redirect the driver's hwlib calls, the layer itself calls the real ones
+*/
+#if (defined(CAM_BUS_TRACE) || defined(CAM_BUS_REPLAY)) && !defined(CAM_BUS_IMPL)
+#define i2c_master_init(device)                                     CAM_bus_i2c_init(device)
+#define i2c_master_transaction(device, addr, tx, txlen, rx, rxlen, t) CAM_bus_i2c_transaction(device, addr, tx, txlen, rx, rxlen, t)
+#define spi_init_dev(device)                                        CAM_bus_spi_init(device)
+#define spi_select_chip(device)                                     CAM_bus_spi_select(device)
+#define spi_unselect_chip(device)                                   CAM_bus_spi_unselect(device)
+#define spi_write(device, data, n)                                  CAM_bus_spi_write(device, data, n)
+#define spi_read(device, data, n)                                   CAM_bus_spi_read(device, data, n)
+#endif
+
+#endif /* _cam_bus_h_ */
+
+/************************/
+/*  End of File Comment */
+/************************/
@@ -27,6 +27,8 @@ ivv-itc@lists.nasa.gov
 /*************************************************************************
 ** Includes
 *************************************************************************/
+#include <string.h>
+
 #include "cam_device.h"
 
 /*************************************************************************
@@ -34,13 +36,39 @@ ivv-itc@lists.nasa.gov
 *************************************************************************/
 i2c_bus_info_t CAM_I2C;
 spi_info_t     CAM_SPI;
+CAM_Session_t  CAM_Session;
+CAM_Wait_t     CAM_Wait[CAM_WAIT_STAGES];
+CAM_Stats_t    CAM_Stats;
 
-/*******************************************************************************
-** Private Function Prototypes
-*******************************************************************************/
-#ifdef OV5642
-static int32_t CAM_setSize_OV5642(void);
-#endif
+/*************************************************************************
+** Private Data
+*************************************************************************/
+static uint32_t   CAM_Fifo_Left; // Bytes of the current capture still in the FIFO, dummy byte included
+static uint32_t   CAM_Fifo_Read; // Bytes handed out since CAM_read_prep
+static uint8_t    CAM_Fifo_Last; // Last byte handed out, a marker may span two reads
+static CAM_Lock_t CAM_Wait_Take; // Held while CAM_Wait is updated, when set
+static CAM_Lock_t CAM_Wait_Give;
+static uint8_t    CAM_Drain_Tail[CAM_DATA_SIZE]; // Bytes after an end of image, kept for the next frame
+
+/*
+** Select the ArduChip, each select starts one SPI transaction
+*/
+static int32_t CAM_select(void)
+{
+    CAM_Stats.spi_transactions++;
+    return spi_select_chip(&CAM_SPI);
+}
+
+/*
+** A new take_picture or burst starts the last capture statistics over
+*/
+static void CAM_stats_start(void)
+{
+    CAM_Stats.fifo_length      = 0;
+    CAM_Stats.bytes_read       = 0;
+    CAM_Stats.spi_transactions = 0;
+    CAM_Stats.capture_ms       = 0;
+}
 
 int32_t CAM_init_i2c(void)
 {
@@ -49,6 +77,7 @@ int32_t CAM_init_i2c(void)
     uint8_t temp   = 0;
     uint8_t vid, pid;
 
+    CAM_PERF_ENTRY(CAM_I2C_INIT_PERF_ID);
     CAM_I2C.handle = CAM_I2C_BUS;
     CAM_I2C.isOpen = PORT_CLOSED;
     CAM_I2C.speed  = CAM_SPEED;
@@ -105,6 +134,110 @@ int32_t CAM_init_i2c(void)
         temp++;
     }
 
+    CAM_session_mark(CAM_STAGE_I2C, result);
+    CAM_PERF_EXIT(CAM_I2C_INIT_PERF_ID);
+    return result;
+}
+
+/*
+** Read an ArduChip register, chip must already be selected
+*/
+static uint8_t CAM_read_reg(uint8_t reg)
+{
+    uint8_t temp[2] = {0x00, 0x00};
+    uint8_t data[2];
+
+    data[0] = reg;
+    data[1] = 0x00;
+    spi_write(&CAM_SPI, data, 2);
+    spi_read(&CAM_SPI, temp, 2);
+    return temp[1];
+}
+
+static int32_t CAM_check_mcu_mode(void)
+{
+    return (CAM_read_reg(ARDUCHIP_MODE) == 0x00) ? OS_SUCCESS : OS_ERROR;
+}
+
+static int32_t CAM_check_sensor_ready(void)
+{
+    int32_t result;
+    uint8_t vid = 0;
+#ifdef OV2640
+    uint8_t data[2];
+    // Change register set to camera
+    data[0] = 0xFF;
+    data[1] = 0x01;
+    i2c_master_transaction(&CAM_I2C, CAM_ADDR, &data, 2, NULL, 0, CAM_TIMEOUT);
+    data[0] = CHIPID_HIGH;
+    data[1] = 0x00;
+    result  = i2c_master_transaction(&CAM_I2C, CAM_ADDR, &data, 2, &vid, 1, CAM_TIMEOUT);
+#endif
+#if (defined(OV5640) || defined(OV5642))
+    uint8_t data[2];
+    data[0] = (CHIPID_HIGH & 0xFF00) >> 8;
+    data[1] = (CHIPID_HIGH & 0x00FF);
+    result  = i2c_master_transaction(&CAM_I2C, CAM_ADDR, &data, 2, &vid, 1, CAM_TIMEOUT);
+#endif
+    // The sensor does not answer until it is out of reset
+    return ((result == OS_SUCCESS) && (vid == CAM_VID)) ? OS_SUCCESS : OS_ERROR;
+}
+
+static int32_t CAM_check_done_clear(void)
+{
+    return (CAM_read_reg(ARDUCHIP_TRIG) & CAP_DONE_MASK) ? OS_ERROR : OS_SUCCESS;
+}
+
+static int32_t CAM_check_done(void)
+{
+    return (CAM_read_reg(ARDUCHIP_TRIG) & CAP_DONE_MASK) ? OS_SUCCESS : OS_ERROR;
+}
+
+int32_t CAM_poll(CAM_Poll_Check_t check, uint8_t stage, uint32_t deadline)
+{
+    int32_t  result = check();
+    uint32_t waited = 0;
+    uint32_t delay  = CAM_POLL_DELAY_MIN;
+    uint16_t polls  = 1;
+
+    while ((result != OS_SUCCESS) && (waited < deadline))
+    {
+        // Spin first, then back off exponentially up to the cap
+        if (polls > CAM_POLL_SPINS)
+        {
+            if (delay > (deadline - waited))
+            {
+                delay = deadline - waited;
+            }
+            OS_TaskDelay(delay);
+            waited += delay;
+            delay = ((delay * 2) < CAM_POLL_DELAY_MAX) ? (delay * 2) : CAM_POLL_DELAY_MAX;
+        }
+        result = check();
+        polls++;
+    }
+
+    if (stage < CAM_WAIT_STAGES)
+    {
+        if (CAM_Wait_Take != NULL)
+        {
+            CAM_Wait_Take();
+        }
+        CAM_Wait[stage].last_ms = waited;
+        CAM_Wait[stage].polls   = polls;
+        if (waited > CAM_Wait[stage].max_ms)
+        {
+            CAM_Wait[stage].max_ms = waited;
+        }
+        if (CAM_Wait_Give != NULL)
+        {
+            CAM_Wait_Give();
+        }
+    }
+#ifdef STF1_DEBUG
+    OS_printf("CAM_poll: stage %d waited %u ms over %d polls \n", stage, (unsigned int)waited, polls);
+#endif
+
     return result;
 }
 
@@ -118,6 +251,8 @@ int32_t CAM_init_spi(void)
     uint8_t readreg[2]      = {0x00, 0x00};
     uint8_t arduchipmode[2] = {0x82, 0x00};
 
+    CAM_PERF_ENTRY(CAM_SPI_INIT_PERF_ID);
+
     // Configure SPI
     CAM_SPI.handle   = 0;
     CAM_SPI.baudrate = CAM_SPEED;
@@ -127,7 +262,7 @@ int32_t CAM_init_spi(void)
     result = spi_init_dev(&CAM_SPI);
 
     // Select chip
-    result = spi_select_chip(&CAM_SPI);
+    result = CAM_select();
 
     if (result == OS_SUCCESS)
     {
@@ -176,10 +311,12 @@ int32_t CAM_init_spi(void)
                     OS_TaskDelay(1);
                 }
                 */
-                OS_TaskDelay(100);
                 // Change mode - MCU
                 spi_write(&CAM_SPI, arduchipmode, 2); // ARDUCHIP_MODE
-                OS_TaskDelay(100);
+                if (CAM_poll(CAM_check_mcu_mode, CAM_WAIT_INIT_SPI, CAM_POLL_DEADLINE) != OS_SUCCESS)
+                {
+                    state = OS_ERROR;
+                }
             }
         }
 
@@ -190,7 +327,13 @@ int32_t CAM_init_spi(void)
             state = OS_ERROR;
         }
     }
+    else
+    {
+        state = OS_ERROR;
+    }
 
+    CAM_session_mark(CAM_STAGE_SPI, state);
+    CAM_PERF_EXIT(CAM_SPI_INIT_PERF_ID);
     return state;
 }
 
@@ -198,9 +341,10 @@ int32_t CAM_config(void)
 {
     uint8_t data[3];
     int32_t result = OS_ERROR;
+    int32_t state  = OS_ERROR;
 
     // Select chip
-    result = spi_select_chip(&CAM_SPI);
+    result = CAM_select();
 
     if (result == OS_SUCCESS)
     { // arducam_init()
@@ -215,7 +359,6 @@ int32_t CAM_config(void)
         i2c_master_transaction(&CAM_I2C, CAM_ADDR, &data, 2, NULL, 0, CAM_TIMEOUT);
 #endif
 #ifdef OV5640
-        OS_TaskDelay(100);
         data[0] = 0x31;
         data[1] = 0x03;
         data[2] = 0x11;
@@ -232,11 +375,13 @@ int32_t CAM_config(void)
         i2c_master_transaction(&CAM_I2C, CAM_ADDR, &data, 3, NULL, 0, CAM_TIMEOUT);
 #endif
 
-        OS_TaskDelay(100);
+        // Give the sensor its minimum reset time, then wait for it to answer
+        OS_TaskDelay(CAM_RESET_SETTLE);
+        state = CAM_poll(CAM_check_sensor_ready, CAM_WAIT_CONFIG, CAM_POLL_DEADLINE);
 
         // Unselect chip
         result = spi_unselect_chip(&CAM_SPI);
-        if (result != OS_SUCCESS)
+        if ((result != OS_SUCCESS) || (state != OS_SUCCESS))
         {
             result = OS_ERROR;
         }
@@ -246,6 +391,7 @@ int32_t CAM_config(void)
         }
     }
 
+    CAM_session_mark(CAM_STAGE_CONFIG, result);
     return result;
 }
 
@@ -265,11 +411,12 @@ int32_t CAM_setup(void)
     i2c_master_transaction(&CAM_I2C, CAM_ADDR, &data, 2, NULL, 0, CAM_TIMEOUT);
 #endif
 
+    CAM_session_mark(CAM_STAGE_SETUP, result);
     return result;
 }
 
 #ifdef OV5642
-static int32_t CAM_setSize_OV5642(void)
+int32_t CAM_setSize_OV5642(void)
 {
     int32_t result = OS_SUCCESS;
     uint8_t data[3];
@@ -294,10 +441,14 @@ static int32_t CAM_setSize_OV5642(void)
 int32_t CAM_capture_prep(void)
 {
     int32_t result = OS_ERROR;
+    int32_t state  = OS_ERROR;
     uint8_t data[2];
 
+    CAM_PERF_ENTRY(CAM_CAPTURE_PREP_PERF_ID);
+    CAM_Fifo_Left = 0;
+
     // Select chip
-    result = spi_select_chip(&CAM_SPI);
+    result = CAM_select();
 
     if (result == OS_SUCCESS)
     { // Prepare for capture
@@ -305,24 +456,24 @@ int32_t CAM_capture_prep(void)
         data[0] = 0x83;
         data[1] = 0x02;
         spi_write(&CAM_SPI, data, 2); // VSYNC is active HIGH
-        OS_TaskDelay(100);
 #endif
         data[0] = 0x84;
         data[1] = 0x01;
         spi_write(&CAM_SPI, data, 2); // Flush the fifo
-        OS_TaskDelay(100);
         data[0] = 0x84;
         data[1] = 0x01;
         spi_write(&CAM_SPI, data, 2); // Clear capture done flag
-        OS_TaskDelay(100);
-        data[0] = 0x84;
-        data[1] = 0x02;
-        spi_write(&CAM_SPI, data, 2); // Start capture
-        OS_TaskDelay(100);
+        state = CAM_poll(CAM_check_done_clear, CAM_WAIT_CAPTURE_PREP, CAM_POLL_DEADLINE);
+        if (state == OS_SUCCESS)
+        {
+            data[0] = 0x84;
+            data[1] = 0x02;
+            spi_write(&CAM_SPI, data, 2); // Start capture
+        }
 
         // Unselect chip
         result = spi_unselect_chip(&CAM_SPI);
-        if (result != OS_SUCCESS)
+        if ((result != OS_SUCCESS) || (state != OS_SUCCESS))
         {
             result = OS_ERROR;
         }
@@ -332,42 +483,24 @@ int32_t CAM_capture_prep(void)
         }
     }
 
+    CAM_PERF_EXIT(CAM_CAPTURE_PREP_PERF_ID);
     return result;
 }
 
 int32_t CAM_capture(void)
 {
-    uint8_t  temp[2] = {0x00, 0x00};
-    int32_t  result  = OS_SUCCESS;
-    int32_t  state   = OS_SUCCESS;
-    uint16_t count   = 0x0000;
-    uint8_t  data[2];
+    int32_t result = OS_SUCCESS;
+    int32_t state  = OS_ERROR;
+
+    CAM_PERF_ENTRY(CAM_CAPTURE_PERF_ID);
 
     // Select chip
-    result = spi_select_chip(&CAM_SPI);
+    result = CAM_select();
 
     if (result == OS_SUCCESS)
     { // Wait for capture done
-        data[0] = 0x41;
-        data[1] = 0x00;
-        spi_write(&CAM_SPI, data, 2);
-        spi_read(&CAM_SPI, temp, 2);
-
-        while (!(((temp[1] & 0xFF)) & CAP_DONE_MASK))
-        {
-            data[0] = 0x41;
-            data[1] = 0x00;
-            spi_write(&CAM_SPI, data, 2);
-            spi_read(&CAM_SPI, temp, 2);
-            count++;
-            OS_TaskDelay(10); // Let other processes run
-            // OS_printf("CAM_capture: temp = 0x%04x \n", temp);
-            if (count >= 0x0400) // Magic number
-            {
-                state = OS_ERROR;
-                break;
-            }
-        }
+        state = CAM_poll(CAM_check_done, CAM_WAIT_CAPTURE, CAM_CAPTURE_DEADLINE);
+        CAM_Stats.capture_ms += CAM_Wait[CAM_WAIT_CAPTURE].last_ms;
 
         // Unselect chip
         result = spi_unselect_chip(&CAM_SPI);
@@ -377,6 +510,7 @@ int32_t CAM_capture(void)
         }
     }
 
+    CAM_PERF_EXIT(CAM_CAPTURE_PERF_ID);
     return state;
 }
 
@@ -387,8 +521,10 @@ int32_t CAM_read_fifo_length(uint32_t *length)
     uint8_t temp[2] = {0x55, 0x55};
     uint8_t data[2];
 
+    CAM_PERF_ENTRY(CAM_FIFO_LENGTH_PERF_ID);
+
     // Select chip
-    result = spi_select_chip(&CAM_SPI);
+    result = CAM_select();
 
     if (result == OS_SUCCESS)
     { // Read FIFO Length
@@ -409,23 +545,21 @@ int32_t CAM_read_fifo_length(uint32_t *length)
         spi_write(&CAM_SPI, data, 2);
         spi_read(&CAM_SPI, temp, 2);
         // OS_printf("CAM_read_fifo_length: temp = 0x%04x \n", temp);
-        data[0] = 0x42;
-        data[1] = 0x00;
-        spi_write(&CAM_SPI, data, 2);
-        spi_read(&CAM_SPI, temp, 2);
-        // OS_printf("CAM_read_fifo_length: temp = 0x%04x \n", temp);
         *length = (*length | (temp[1] & 0x00FF)) & 0x007FFFFF;
+        CAM_Stats.fifo_length = *length;
 #ifdef STF1_DEBUG
         OS_printf("\n CAM FIFO Length = %d  = 0x%08x\n", (int)*length, (int)*length);
 #endif
 
         if ((*length > MAX_FIFO_SIZE) || (*length == 0))
         {
+            OS_printf("CAM_read_fifo_length: bad FIFO length %u \n", (unsigned int)*length);
             state = OS_ERROR;
-
-            state = OS_SUCCESS; // DEBUG
         }
 
+        // The drain reads exactly this much, the first byte out of the FIFO is a stale dummy
+        CAM_Fifo_Left = (state == OS_SUCCESS) ? (*length + 1) : 0;
+
         // Unselect chip
         result = spi_unselect_chip(&CAM_SPI);
         if (result != OS_SUCCESS)
@@ -434,6 +568,7 @@ int32_t CAM_read_fifo_length(uint32_t *length)
         }
     }
 
+    CAM_PERF_EXIT(CAM_FIFO_LENGTH_PERF_ID);
     return state;
 }
 
@@ -443,37 +578,47 @@ int32_t CAM_read_prep(char *buf, uint16_t *i)
     uint8_t  temp[2] = {0x00, 0x00};
     int32_t  result  = OS_SUCCESS;
     int32_t  state   = OS_SUCCESS;
-    uint16_t count   = 0x0000;
+    uint32_t count   = 0;
+    uint32_t length  = 0;
     uint8_t  data[2] = {0x00, 0x00};
 
+    CAM_PERF_ENTRY(CAM_READ_PREP_PERF_ID);
+
 #ifdef FILE_OUTPUT
     remove("pic.jpg");
 #endif
 
+    // The drain is bounded by the FIFO length, read it if the caller has not
+    if ((CAM_Fifo_Left == 0) && (CAM_read_fifo_length(&length) != OS_SUCCESS))
+    {
+        CAM_PERF_EXIT(CAM_READ_PREP_PERF_ID);
+        return OS_ERROR;
+    }
+
     // Select chip
-    result  = spi_select_chip(&CAM_SPI);
+    result  = CAM_select();
     data[0] = 0xBD;
     data[1] = 0x00;
     spi_write(&CAM_SPI, data, 2);
     spi_read(&CAM_SPI, temp, 2);
+    count++;
+
+    // That was the stale dummy byte, never part of the image even if it reads 0xFF
+    temp[1] = 0x00;
 
     if (result == OS_SUCCESS)
-    { // Read until JPEG header
-        while (temp[1] != 0xFF)
+    { // Skip anything ahead of the JPEG header
+        while ((temp[1] != 0xFF) && (count < CAM_Fifo_Left))
         {
             data[0] = 0x3D;
             data[1] = 0x00;
             spi_write(&CAM_SPI, data, 2);
             spi_read(&CAM_SPI, temp, 2);
-            // OS_printf("CAM_read_prep: temp = 0x%04x \n", temp);
-            temp[1] = (temp[1] & 0xFF);
-
             count++;
-            if (count > 500) // Magic Number
-            {
-                state   = OS_ERROR;
-                temp[1] = 0xFF;
-            }
+        }
+        if (temp[1] != 0xFF)
+        {
+            state = OS_ERROR;
         }
 
         // Unselect chip
@@ -490,16 +635,31 @@ int32_t CAM_read_prep(char *buf, uint16_t *i)
         }
     }
 
+    CAM_Stats.bytes_read += count;
+    CAM_Fifo_Left = (count < CAM_Fifo_Left) ? (CAM_Fifo_Left - count) : 0;
+    CAM_Fifo_Read = 1;
+    CAM_Fifo_Last = temp[1];
+
+    CAM_PERF_EXIT(CAM_READ_PREP_PERF_ID);
     return state;
 }
 
-int32_t CAM_read(char *buf, uint16_t *i, uint8_t *status)
+int32_t CAM_read(char *buf, uint16_t *i, uint16_t size, uint8_t *status)
 {
     // Local variables
-    uint8_t temp[2]      = {0x00, 0x00};
-    uint8_t temp_last[2] = {0x00, 0xFF};
-    int32_t result       = OS_SUCCESS;
-    uint8_t spiw[2]      = {0x3D, 0x00}; // FIFO read
+    uint8_t  eoi     = 0;
+    int32_t  result  = OS_SUCCESS;
+    uint8_t  spiw[2] = {ARDUCHIP_SINGLE_FIFO_READ, 0x00}; // FIFO read
+    uint16_t start   = *i;
+    uint32_t want;
+    uint32_t end;
+#if (CAM_BURST_CHUNK_SIZE > 0)
+    uint16_t chunk;
+#else
+    uint8_t temp[2] = {0x00, 0x00};
+#endif
+
+    CAM_PERF_ENTRY(CAM_FIFO_CHUNK_PERF_ID);
 
 #ifdef FILE_OUTPUT
     FILE *fp1 = fopen("./pic.jpg", "a");
@@ -510,83 +670,78 @@ int32_t CAM_read(char *buf, uint16_t *i, uint8_t *status)
 #endif
 
     // Select chip
-    result = spi_select_chip(&CAM_SPI);
+    result = CAM_select();
 
     if (result == OS_SUCCESS)
-    { // Read JPEG data from FIFO
-        while ((((temp[1] != 0xD9) || (temp[0] != 0x00)) || ((temp_last[1] != 0xFF) || (temp_last[0] != 0x00))) &&
-               (*i < CAM_DATA_SIZE))
-        {
-            temp_last[0] = temp[0];
-            temp_last[1] = temp[1];
-            spiw[0]      = 0x3D;
-            spiw[1]      = 0x00;
+    { // Fill the rest of buf, never past what the FIFO length says is there
+        want = size - *i;
+        if (want > CAM_Fifo_Left)
+        {
+            want = CAM_Fifo_Left;
+        }
+#if (CAM_BURST_CHUNK_SIZE > 0)
+        // Single burst command, then clock out the FIFO a chunk at a time
+        spiw[0] = ARDUCHIP_BURST_FIFO_READ;
+        spi_write(&CAM_SPI, spiw, 1);
+
+        while (want > 0)
+        {
+            chunk = (want > CAM_BURST_CHUNK_SIZE) ? CAM_BURST_CHUNK_SIZE : want;
+            spi_read(&CAM_SPI, (uint8_t *)&buf[*i], chunk);
+            *i += chunk;
+            want -= chunk;
+        }
+#else
+        while (want > 0)
+        {
             spi_write(&CAM_SPI, spiw, 2);
             spi_read(&CAM_SPI, temp, 2);
-
-            // Write image data to buffer
-            temp[0]     = (temp[0] & 0x00);
-            temp[1]     = (temp[1] & 0xFF);
             buf[(*i)++] = temp[1];
+            want--;
+        }
+#endif
+        CAM_Stats.bytes_read += *i - start;
+        CAM_Fifo_Left -= *i - start;
 
-            if (temp_last[0] == 0x00)
+        // Check the piece now it is in RAM, anything past the end of image is discarded
+        if ((CAM_Fifo_Read == 1) && (*i > start) && ((uint8_t)buf[start] != CAM_JPEG_SOI))
+        {
+            OS_printf("CAM_read: no start of image \n");
+            *status = CAM_READ_INVALID;
+        }
+        else
+        {
+            end = CAM_jpeg_find_marker(CAM_Fifo_Last, (uint8_t *)&buf[start], *i - start, CAM_JPEG_EOI);
+            if (end > 0)
             {
-                switch (temp_last[1])
-                {
-                    case 0xFF:
-                        if (temp[0] == 0x00)
-                        {
-                            switch (temp[1])
-                            {
-                                case 0xD8:
-                                    (*status)++;
-#ifdef STF1_DEBUG
-                                    OS_printf("\n Start of image...\n");
-#endif
-                                    break;
-                                case 0xDA:
-                                    (*status)++;
-#ifdef STF1_DEBUG
-                                    OS_printf("\n Start of scan...\n");
-#endif
-                                    break;
-                                case 0xDB:
-                                    (*status)++;
-#ifdef STF1_DEBUG
-                                    OS_printf("\n Define quantization table(s)...\n");
-#endif
-                                    break;
-                                case 0xC4:
-                                    (*status)++;
-#ifdef STF1_DEBUG
-                                    OS_printf("\n Define huffman table(s)...\n");
-#endif
-                                    break;
-                                case 0xD3:
-                                    (*status)++;
-#ifdef STF1_DEBUG
-                                    OS_printf("\n What is that!?!? \n");
-#endif
-                                    break;
-                                case 0xD9:
-                                    (*status)++;
-#ifdef STF1_DEBUG
-                                    OS_printf("\n End of image...\n");
+                *i      = start + end;
+                *status = OS_SUCCESS;
+                eoi     = 1;
+            }
+            else if (CAM_Fifo_Left == 0)
+            {
+                OS_printf("CAM_read: FIFO drained without an end of image \n");
+                *status = CAM_READ_INVALID;
+            }
+        }
+        CAM_Fifo_Read += *i - start;
+        if (*i > start)
+        {
+            CAM_Fifo_Last = (uint8_t)buf[*i - 1];
+        }
+
+        if (eoi == 1)
+        {
+#if (CAM_BURST_CHUNK_SIZE > 0)
+            // Leave burst mode before issuing the next command
+            spi_unselect_chip(&CAM_SPI);
+            CAM_select();
 #endif
-                                    (*status) = OS_SUCCESS;
-                                    spiw[0]   = 0x84;
-                                    spiw[0]   = 0x01; // Clear the capture done flag
-                                    spi_write(&CAM_SPI, spiw, 2);
-                                    break;
-                                default:
-                                    break;
-                            }
-                        } // end if (temp[0] == 0x00)
-                        break;
-                    default:
-                        break;
-                }
-            } // end if (temp_last[0] == 0x00)
+            spiw[0] = 0x84;
+            spiw[1] = 0x01; // Clear the capture done flag
+            spi_write(&CAM_SPI, spiw, 2);
+            CAM_Stats.frames++;
+            CAM_Fifo_Left = 0;
         }
 
         // Unselect chip
@@ -607,97 +762,391 @@ int32_t CAM_read(char *buf, uint16_t *i, uint8_t *status)
     fclose(fp1);
 #endif
 
+    CAM_PERF_EXIT(CAM_FIFO_CHUNK_PERF_ID);
     return result;
 }
 
-int take_picture(uint8_t size)
+/*
+** Program how many frames the next capture puts in the FIFO
+*/
+static int32_t CAM_set_frames(uint8_t frames)
 {
-    uint8_t  status = 1;
-    uint32_t length = 0;
-    uint8_t  data[CAM_DATA_SIZE];
-    uint16_t x           = 0;
-    int32_t  result      = OS_ERROR;
-    int32_t  read_result = OS_SUCCESS;
+    int32_t result;
+    uint8_t data[2];
 
-    while (status == 1)
+    // Select chip
+    result = CAM_select();
+
+    if (result == OS_SUCCESS)
     {
-        // Initialize Inter-Integrated Circuit
-        result = CAM_init_i2c();
-        if (result != OS_SUCCESS)
-            return OS_ERROR;
-        OS_printf("I2C initialization success\n");
+        data[0] = ARDUCHIP_FRAMES | 0x80;
+        data[1] = frames - 1;
+        spi_write(&CAM_SPI, data, 2);
 
-        // Initialize Serial Peripheral Interface
-        result = CAM_init_spi();
-        if (result != OS_SUCCESS)
-            return OS_ERROR;
-        OS_printf("SPI initialization success\n");
+        // Unselect chip
+        result = spi_unselect_chip(&CAM_SPI);
+    }
 
-        // Configure Camera for Upload
-        result = CAM_config();
-        if (result != OS_SUCCESS)
-            return OS_ERROR;
-        OS_printf("Configuration success\n");
+    return result;
+}
 
-        // Configure Registers
-        result = CAM_jpeg_init();
-        if (result != OS_SUCCESS)
-            return OS_ERROR;
-        OS_printf("JPEG init success\n");
+/*
+** Drain every frame of one capture out of the FIFO. Like CAM_read each piece is
+** clocked straight into *buf, bounded by the FIFO length, and checked once it is
+** in RAM. The length covers every frame of the capture, not each one, so frames
+** are still split on their markers.
+*/
+static int32_t CAM_drain_frames(uint8_t first, uint8_t frames, uint32_t length, char **buf, uint16_t size,
+                                CAM_Frame_Sink_t sink)
+{
+    int32_t  result   = OS_SUCCESS;
+    int32_t  state    = OS_SUCCESS;
+    uint8_t  frame    = 0;
+    uint8_t  in_image = 0;
+    uint8_t  last     = 0x00;
+    uint16_t fill     = 0; // Bytes of the current frame in *buf
+    uint16_t tail     = 0; // Bytes in CAM_Drain_Tail still to check
+    uint16_t start;
+    uint16_t want;
+    uint32_t end;
+    uint8_t  spiw[2] = {ARDUCHIP_SINGLE_FIFO_READ, 0x00};
+    uint8_t  temp[2] = {0x00, 0x00};
+#if (CAM_BURST_CHUNK_SIZE > 0)
+    uint16_t chunk;
+#endif
 
-        // Configure Registers
-        result = CAM_yuv422();
-        if (result != OS_SUCCESS)
-            return OS_ERROR;
-        OS_printf("YUV422 success\n");
+    // What follows an end of image has to fit in CAM_Drain_Tail
+    if (size > sizeof(CAM_Drain_Tail))
+    {
+        size = sizeof(CAM_Drain_Tail);
+    }
 
-        // Configure Registers
-        result = CAM_jpeg();
-        if (result != OS_SUCCESS)
-            return OS_ERROR;
-        OS_printf("JPEG success\n");
+    // Select chip
+    result = CAM_select();
 
-        // Configure Camera for Size
-        result = CAM_setup();
+    if (result == OS_SUCCESS)
+    { // The first byte out of the FIFO is a stale dummy
+#if (CAM_BURST_CHUNK_SIZE > 0)
+        spiw[0] = ARDUCHIP_BURST_FIFO_READ;
+        spi_write(&CAM_SPI, spiw, 1);
+        spi_read(&CAM_SPI, temp, 1);
+#else
+        spi_write(&CAM_SPI, spiw, 2);
+        spi_read(&CAM_SPI, temp, 2);
+#endif
+        CAM_Stats.bytes_read++;
+
+        while (((length > 0) || (tail > 0)) && (frame < frames) && (state == OS_SUCCESS))
+        {
+            CAM_PERF_ENTRY(CAM_DRAIN_CHUNK_PERF_ID);
+            start = fill;
+            if (tail > 0)
+            {
+                // Start of the next frame came out with the end of the last one
+                memcpy(&(*buf)[fill], CAM_Drain_Tail, tail);
+                fill += tail;
+                tail = 0;
+            }
+            else
+            { // Fill the rest of buf, never past what the FIFO length says is there
+                want = size - fill;
+                if (want > length)
+                {
+                    want = length;
+                }
+#if (CAM_BURST_CHUNK_SIZE > 0)
+                while (fill < (start + want))
+                {
+                    chunk = (start + want) - fill;
+                    if (chunk > CAM_BURST_CHUNK_SIZE)
+                    {
+                        chunk = CAM_BURST_CHUNK_SIZE;
+                    }
+                    spi_read(&CAM_SPI, (uint8_t *)&(*buf)[fill], chunk);
+                    fill += chunk;
+                }
+#else
+                while (fill < (start + want))
+                {
+                    spi_write(&CAM_SPI, spiw, 2);
+                    spi_read(&CAM_SPI, temp, 2);
+                    (*buf)[fill++] = temp[1];
+                }
+#endif
+                length -= want;
+                CAM_Stats.bytes_read += want;
+            }
+
+            // Skip anything between frames until the next start of image
+            if (in_image == 0)
+            {
+                end  = CAM_jpeg_find_marker(last, (uint8_t *)&(*buf)[start], fill - start, CAM_JPEG_SOI);
+                last = (uint8_t)(*buf)[fill - 1];
+                if (end == 0)
+                { // A trailing 0xFF may be the first half of the marker
+                    (*buf)[0] = (char)last;
+                    fill      = (last == 0xFF) ? 1 : 0;
+                }
+                else
+                { // Frame goes at the front of buf
+                    if ((start + end) != 2)
+                    {
+                        memmove(&(*buf)[2], &(*buf)[start + end], fill - (start + end));
+                    }
+                    (*buf)[0] = 0xFF;
+                    (*buf)[1] = 0xD8;
+                    fill      = 2 + fill - (start + end);
+                    start     = 2;
+                    in_image  = 1;
+                    last      = 0xD8;
+                }
+            }
+
+            // Check the rest of the piece for the end of image
+            if ((in_image == 1) && (fill > start))
+            {
+                end  = CAM_jpeg_find_marker(last, (uint8_t *)&(*buf)[start], fill - start, CAM_JPEG_EOI);
+                last = (uint8_t)(*buf)[fill - 1];
+                if (end > 0)
+                {
+                    // Keep what follows before the sink takes *buf
+                    tail = fill - (start + end);
+                    memcpy(CAM_Drain_Tail, &(*buf)[start + end], tail);
+                    state    = sink(first + frame, buf, start + end, 1);
+                    fill     = 0;
+                    in_image = 0;
+                    last     = 0x00;
+                    frame++;
+                    CAM_Stats.frames++;
+                }
+                else if (fill == size)
+                {
+                    state = sink(first + frame, buf, fill, 0);
+                    fill  = 0;
+                }
+                if ((*buf == NULL) && (frame < frames))
+                {
+                    state = OS_ERROR;
+                }
+            }
+            CAM_PERF_EXIT(CAM_DRAIN_CHUNK_PERF_ID);
+        }
+
+        // Leave burst mode and clear the capture done flag
+        spi_unselect_chip(&CAM_SPI);
+        CAM_select();
+        spiw[0] = 0x84;
+        spiw[1] = 0x01;
+        spi_write(&CAM_SPI, spiw, 2);
+
+        // Unselect chip
+        result = spi_unselect_chip(&CAM_SPI);
         if (result != OS_SUCCESS)
-            return OS_ERROR;
-        OS_printf("Configuration success\n");
+        {
+            state = OS_ERROR;
+        }
+    }
+    else
+    {
+        state = OS_ERROR;
+    }
+
+    if ((state == OS_SUCCESS) && (frame < frames))
+    {
+        OS_printf("CAM_drain_frames: FIFO ended after %d of %d frames \n", frame, frames);
+        state = OS_ERROR;
+    }
+
+    return state;
+}
+
+int32_t CAM_capture_burst(uint8_t frames, char **buf, uint16_t size, CAM_Frame_Sink_t sink)
+{
+    int32_t  result = OS_SUCCESS;
+    uint32_t length = 0;
+    uint8_t  done   = 0;
+    uint8_t  batch;
+
+    CAM_stats_start();
+
+    // Each capture fills the FIFO with up to ARDUCHIP_MAX_FRAMES frames, drained before the next
+    while ((done < frames) && (result == OS_SUCCESS))
+    {
+        batch = frames - done;
+        if (batch > ARDUCHIP_MAX_FRAMES)
+        {
+            batch = ARDUCHIP_MAX_FRAMES;
+        }
+
+        result = CAM_set_frames(batch);
+        if (result == OS_SUCCESS)
+        {
+            result = CAM_capture_prep();
+        }
+        if (result == OS_SUCCESS)
+        {
+            result = CAM_capture();
+        }
+        if (result == OS_SUCCESS)
+        {
+            result = CAM_read_fifo_length(&length);
+        }
+        if (result == OS_SUCCESS)
+        {
+            result = CAM_drain_frames(done, batch, length, buf, size, sink);
+        }
+#ifdef STF1_DEBUG
+        OS_printf("CAM_capture_burst: frames %d to %d, FIFO length %u, result %d \n", done, done + batch - 1,
+                  (unsigned int)length, (int)result);
+#endif
+        done += batch;
+    }
+
+    // Back to single frame captures
+    if (CAM_set_frames(1) != OS_SUCCESS)
+    {
+        result = OS_ERROR;
+    }
+
+    return result;
+}
+
+void CAM_session_mark(uint8_t stage, int32_t result)
+{
+    // Stages build on each other, redoing one undoes the ones after it. A bus
+    // brought up again means the camera may have been reset or power cycled.
+    CAM_Session.stages &= (uint8_t)((stage << 1) - 1);
 
-        // Upload Size
+    if (result == OS_SUCCESS)
+    {
+        CAM_Session.stages |= stage;
+    }
+    else
+    {
+        CAM_Session.stages &= (uint8_t)~stage;
+    }
+}
+
+int32_t CAM_session_open(uint8_t size)
+{
+    int32_t  result = OS_SUCCESS;
+    uint32_t n;
+    static const struct
+    {
+        uint8_t     stage;
+        int32_t     (*apply)(void);
+        const char *name;
+    } stages[] = {
+        {CAM_STAGE_SPI, CAM_init_spi, "SPI initialization"},
+        {CAM_STAGE_I2C, CAM_init_i2c, "I2C initialization"},
+        {CAM_STAGE_CONFIG, CAM_config, "Configuration"},
+        {CAM_STAGE_JPEG_INIT, CAM_jpeg_init, "JPEG init"},
+        {CAM_STAGE_YUV422, CAM_yuv422, "YUV422"},
+        {CAM_STAGE_JPEG, CAM_jpeg, "JPEG"},
+        {CAM_STAGE_SETUP, CAM_setup, "Setup"},
+    };
+
+    // Only the size stage depends on the requested image
+    if (CAM_Session.size != size)
+    {
+        CAM_Session.stages &= (uint8_t)~CAM_STAGE_SIZE;
+    }
+
+    for (n = 0; (n < (sizeof(stages) / sizeof(stages[0]))) && (result == OS_SUCCESS); n++)
+    {
+        if ((CAM_Session.stages & stages[n].stage) == 0)
+        {
+            result = stages[n].apply();
+            if (result != OS_SUCCESS)
+            {
+                OS_printf("CAM session: %s failed\n", stages[n].name);
+            }
+#ifdef STF1_DEBUG
+            else
+            {
+                OS_printf("CAM session: %s success\n", stages[n].name);
+            }
+#endif
+        }
+    }
+
+    if ((result == OS_SUCCESS) && ((CAM_Session.stages & CAM_STAGE_SIZE) == 0))
+    {
         result = CAM_setSize(size);
         if (result != OS_SUCCESS)
-            return OS_ERROR;
-        OS_printf("Set size success\n");
+        {
+            OS_printf("CAM session: Set size failed\n");
+        }
+    }
+
+    return result;
+}
+
+void CAM_session_close(void)
+{
+    // Everything is applied again on the next open
+    CAM_Session.stages = 0;
+}
+
+void CAM_stats_reset(void)
+{
+    memset(&CAM_Stats, 0, sizeof(CAM_Stats));
+}
+
+void CAM_wait_lock(CAM_Lock_t take, CAM_Lock_t give)
+{
+    CAM_Wait_Take = take;
+    CAM_Wait_Give = give;
+}
+
+int take_picture(uint8_t size)
+{
+    uint8_t  status = 1;
+    uint32_t length = 0;
+    uint8_t  data[CAM_DATA_SIZE];
+    uint16_t x           = 0;
+    int32_t  result      = OS_ERROR;
+    int32_t  read_result = OS_SUCCESS;
+
+    CAM_stats_start();
+
+    while (status == 1)
+    {
+        // Bring up the camera, stages already applied are skipped
+        result = CAM_session_open(size);
+        if (result != OS_SUCCESS)
+            break;
+        OS_printf("Session open success\n");
 
         // Prepare for Capture
         result = CAM_capture_prep();
         if (result != OS_SUCCESS)
-            return OS_ERROR;
+            break;
         OS_printf("Capture prep success\n");
 
         // Capture Image
         result = CAM_capture();
         if (result != OS_SUCCESS)
-            return OS_ERROR;
+            break;
         OS_printf("Capture success\n");
 
         // Read FIFO Size
         result = CAM_read_fifo_length(&length);
         if (result != OS_SUCCESS)
-            return OS_ERROR;
+            break;
         OS_printf("Read fifo length success\n");
 
         // Prepare for FIFO Read
         result = CAM_read_prep((char *)&data, (uint16_t *)&x);
         if (result != OS_SUCCESS)
-            return OS_ERROR;
+            break;
         OS_printf("Read prep success\n");
 
-        //// Read FIFO
+        // Read FIFO, the capture is done and its FIFO length bounds every read
         while ((status > 0) && (status <= 8))
         {
 
-            read_result = CAM_read((char *)&data, (uint16_t *)&x, (uint8_t *)&status);
+            read_result = CAM_read((char *)&data, (uint16_t *)&x, CAM_DATA_SIZE, (uint8_t *)&status);
 
             if (read_result != OS_SUCCESS)
             {
@@ -706,16 +1155,24 @@ int take_picture(uint8_t size)
             if (read_result != OS_SUCCESS)
                 break;
             x = 0;
-
-            OS_TaskDelay(250);
         }
 
         if (status != OS_SUCCESS)
-            return OS_ERROR;
+        {
+            result = OS_ERROR;
+            break;
+        }
         OS_printf("FIFO success\n");
         break;
     }
 
+    // Start from scratch next time if anything went wrong
+    if (result != OS_SUCCESS)
+    {
+        CAM_session_close();
+        return OS_ERROR;
+    }
+
     return OS_SUCCESS;
 }
 
@@ -21,7 +21,10 @@ ivv-itc@lists.nasa.gov
 
 #include "device_cfg.h"
 #include "hwlib.h"
+#include "cam_bus.h"
 #include "cam_platform_cfg.h"
+#include "cam_perf.h"
+#include "cam_jpeg.h"
 #include "cam_registers.h"
 
 /************************************************************************
@@ -52,6 +55,7 @@ ivv-itc@lists.nasa.gov
 #define CAM_VID       0x56
 #define CAM_PID       0x40
 #define MAX_FIFO_SIZE 0x7FFFFF // 8MByte
+#define SYSTEM_CTRL   0x3008
 #endif
 #ifdef OV5642
 #define CAM_ADDR      0x3C
@@ -60,6 +64,7 @@ ivv-itc@lists.nasa.gov
 #define CAM_VID       0x56
 #define CAM_PID       0x42
 #define MAX_FIFO_SIZE 0x7FFFFF // 8MByte
+#define SYSTEM_CTRL   0x3008
 #endif
 
 #define size_160x120   0
@@ -93,13 +98,99 @@ ivv-itc@lists.nasa.gov
 /****************************************************/
 /* ArduChip related definition 						*/
 /****************************************************/
-#define ARDUCHIP_MODE 0x02 // Mode register
+#define ARDUCHIP_FRAMES           0x01 // Capture control, number of frames minus one
+#define ARDUCHIP_MODE             0x02 // Mode register
+#define ARDUCHIP_BURST_FIFO_READ  0x3C // Burst FIFO read operation
+#define ARDUCHIP_SINGLE_FIFO_READ 0x3D // Single FIFO read operation
+#define ARDUCHIP_TRIG             0x41 // Trigger source
+#define ARDUCHIP_MAX_FRAMES       7    // Frames captured into the FIFO at once
+#define CAM_READ_INVALID          0xFF // CAM_read status for a FIFO drained without a valid image
+
+/****************************************************/
+/* Session related definition 						*/
+/****************************************************/
+// Configuration stages in the order they are applied
+#define CAM_STAGE_SPI       0x01
+#define CAM_STAGE_I2C       0x02
+#define CAM_STAGE_CONFIG    0x04
+#define CAM_STAGE_JPEG_INIT 0x08
+#define CAM_STAGE_YUV422    0x10
+#define CAM_STAGE_JPEG      0x20
+#define CAM_STAGE_SETUP     0x40
+#define CAM_STAGE_SIZE      0x80
+
+/*
+** Tracks which stages are applied so later images only capture and read
+*/
+typedef struct
+{
+    uint8_t stages; /* CAM_STAGE_* currently applied to the hardware */
+    uint8_t size;   /* Size programmed by the last CAM_setSize */
+} CAM_Session_t;
+
+/****************************************************/
+/* Status polling related definition 				*/
+/****************************************************/
+// Stages that wait on a hardware status
+#define CAM_WAIT_INIT_SPI     0
+#define CAM_WAIT_CONFIG       1
+#define CAM_WAIT_CAPTURE_PREP 2
+#define CAM_WAIT_CAPTURE      3
+#define CAM_WAIT_STAGES       4
+
+/*
+** Status check used by the polling engine, OS_SUCCESS once the condition is met
+*/
+typedef int32_t (*CAM_Poll_Check_t)(void);
+
+/*
+** Observed wait for one stage, used to tune the back-off caps
+*/
+typedef struct
+{
+    uint32_t last_ms; /* Delay spent on the last poll of this stage */
+    uint32_t max_ms;  /* Longest delay seen since boot */
+    uint16_t polls;   /* Status reads on the last poll of this stage */
+} CAM_Wait_t;
+
+/****************************************************/
+/* Capture statistics related definition 			*/
+/****************************************************/
+/*
+** Driver side numbers behind the capture telemetry. The last capture fields
+** start over with each take_picture or burst, the rest count since a reset.
+*/
+typedef struct
+{
+    uint32_t fifo_length;      /* FIFO length of the last capture */
+    uint32_t bytes_read;       /* Bytes clocked out of the FIFO for the last capture */
+    uint32_t spi_transactions; /* Chip selects for the last capture */
+    uint32_t capture_ms;       /* Capture done wait summed over the last capture */
+    uint32_t i2c_errors;       /* Failed register writes arducam_i2c_write_regs let through */
+    uint32_t frames;           /* Complete frames read out of the FIFO */
+} CAM_Stats_t;
+
+/*
+** Receives burst capture data, *buf holds length bytes of frame and eoi is set on
+** the last piece of each frame. The sink takes ownership of *buf and replaces it
+** with the buffer to fill next, which may be NULL after the last frame. Anything
+** but OS_SUCCESS stops the burst.
+*/
+typedef int32_t (*CAM_Frame_Sink_t)(uint8_t frame, char **buf, uint16_t length, uint8_t eoi);
+
+/*
+** Lock taken around CAM_Wait updates, for apps that read it from another task
+*/
+typedef void (*CAM_Lock_t)(void);
 
 /*************************************************************************
 ** Global Data
 *************************************************************************/
 extern i2c_bus_info_t CAM_I2C;
 extern spi_info_t     CAM_SPI;
+extern CAM_Session_t  CAM_Session;
+extern CAM_Wait_t     CAM_Wait[CAM_WAIT_STAGES];
+extern CAM_Stats_t    CAM_Stats;
 
 /*************************************************************************
 ** Exported Functions
@@ -111,7 +202,17 @@ extern int32_t CAM_capture_prep(void);
 extern int32_t CAM_capture(void);
 extern int32_t CAM_read_fifo_length(uint32_t *length);
 extern int32_t CAM_read_prep(char *buf, uint16_t *i);
-extern int32_t CAM_read(char *buf, uint16_t *i, uint8_t *status);
+extern int32_t CAM_read(char *buf, uint16_t *i, uint16_t size, uint8_t *status);
+extern int32_t CAM_poll(CAM_Poll_Check_t check, uint8_t stage, uint32_t deadline);
+extern int32_t CAM_capture_burst(uint8_t frames, char **buf, uint16_t size, CAM_Frame_Sink_t sink);
+extern void    CAM_session_mark(uint8_t stage, int32_t result);
+extern int32_t CAM_session_open(uint8_t size);
+extern void    CAM_session_close(void);
+extern void    CAM_stats_reset(void);
+extern void    CAM_wait_lock(CAM_Lock_t take, CAM_Lock_t give);
+#ifdef OV5642
+extern int32_t CAM_setSize_OV5642(void);
+#endif
 int            take_picture(uint8_t size);
 
 #endif /* _cam_device_h_ */
@@ -0,0 +1,223 @@
+/* Copyright (C) 2009 - 2017 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S.
+Government.
+
+This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including,
+but not limited to, any warranty that the software will conform to, specifications any implied warranties of
+merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+documentation will conform to the program, or any warranty that the software will be error free.
+
+In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+consequential damages, arising out of, resulting from, or in any way connected with the software or its documentation.
+Whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained from, or arose
+out of the results of, or use of, the software, documentation or services provided hereunder
+
+ITC Team
+NASA IV&V
+ivv-itc@lists.nasa.gov
+*/
+
+/*******************************************************************************
+** File: cam_jpeg.c
+**
+** Purpose:
+**   Locates JPEG markers in image data already in RAM.
+**
+*******************************************************************************/
+
+/*************************************************************************
+** Includes
+*************************************************************************/
+#include "cam_jpeg.h"
+
+#include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+** Offset of the first 0xFF at or after pos, length when there is none.
+** Looks at 16 bytes at a time with SSE2, otherwise 8 at a time in a word.
+*/
+static uint32_t CAM_jpeg_find_ff(const uint8_t *data, uint32_t pos, uint32_t length)
+{
+#if defined(__SSE2__)
+    const __m128i ff = _mm_set1_epi8((char)0xFF);
+    uint32_t      mask;
+
+    if (pos >= length)
+    {
+        return length;
+    }
+
+    while ((length - pos) >= 16)
+    {
+        mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)&data[pos]), ff));
+        if (mask != 0)
+        {
+            return pos + (uint32_t)__builtin_ctz(mask);
+        }
+        pos += 16;
+    }
+#else
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t high = 0x8080808080808080ULL;
+    uint64_t       word;
+
+    if (pos >= length)
+    {
+        return length;
+    }
+
+    // A 0xFF byte is a zero byte of the inverted word
+    while ((length - pos) >= 8)
+    {
+        memcpy(&word, &data[pos], sizeof(word));
+        word = ~word;
+        if (((word - ones) & ~word & high) != 0)
+        {
+            break;
+        }
+        pos += 8;
+    }
+#endif
+    while ((pos < length) && (data[pos] != 0xFF))
+    {
+        pos++;
+    }
+    return pos;
+}
+
+/*
+** Offset just past the first FF <marker> in data, 0 when there is none.
+** last is the byte before data so a marker split across two reads is found.
+*/
+uint32_t CAM_jpeg_find_marker(uint8_t last, const uint8_t *data, uint32_t length, uint8_t marker)
+{
+    uint32_t pos = 0;
+
+    if ((length > 0) && (last == 0xFF) && (data[0] == marker))
+    {
+        return 1;
+    }
+    if (length < 2)
+    {
+        return 0;
+    }
+    while ((pos = CAM_jpeg_find_ff(data, pos, length)) < (length - 1))
+    {
+        if (data[pos + 1] == marker)
+        {
+            return pos + 2;
+        }
+        pos++;
+    }
+    return 0;
+}
+
+static void CAM_jpeg_add(CAM_Jpeg_Index_t *index, uint32_t offset, uint8_t marker)
+{
+    if (index->count < CAM_JPEG_MAX_MARKERS)
+    {
+        index->markers[index->count].offset = offset;
+        index->markers[index->count].marker = marker;
+        index->count++;
+    }
+}
+
+/*
+** Segments ahead of a scan carry their length and are hopped over, only the
+** entropy coded data is scanned for 0xFF. Stuffed FF 00 and fill bytes are
+** skipped, a restart stays in the scan and any other marker ends it.
+*/
+int32_t CAM_jpeg_index(const uint8_t *data, uint32_t length, CAM_Jpeg_Index_t *index)
+{
+    uint32_t pos = 2;
+    uint32_t segment;
+    uint8_t  marker;
+
+    memset(index, 0, sizeof(*index));
+    if ((length < 2) || (data[0] != 0xFF) || (data[1] != CAM_JPEG_SOI))
+    {
+        return OS_ERROR;
+    }
+    CAM_jpeg_add(index, 0, CAM_JPEG_SOI);
+
+    while ((pos + 1) < length)
+    {
+        if (data[pos] != 0xFF)
+        {
+            return OS_ERROR;
+        }
+        while (((pos + 1) < length) && (data[pos + 1] == 0xFF))
+        {
+            pos++;
+        }
+        if ((pos + 1) >= length)
+        {
+            break;
+        }
+        marker = data[pos + 1];
+        CAM_jpeg_add(index, pos, marker);
+
+        if (marker == CAM_JPEG_EOI)
+        {
+            index->length = pos + 2;
+            return (index->scan > 0) ? OS_SUCCESS : OS_ERROR;
+        }
+        if (((marker & 0xF8) == CAM_JPEG_RST0) || (marker == 0x01))
+        {
+            pos += 2;
+            continue;
+        }
+
+        if ((pos + 4) > length)
+        {
+            break;
+        }
+        segment = ((uint32_t)data[pos + 2] << 8) | data[pos + 3];
+        if ((marker == CAM_JPEG_DRI) && (segment >= 4) && ((pos + 6) <= length))
+        {
+            index->restart_interval = (uint16_t)((data[pos + 4] << 8) | data[pos + 5]);
+        }
+        pos += 2 + segment;
+
+        // The length comes from the frame, a corrupt one points past the end
+        if (pos > length)
+        {
+            return OS_ERROR;
+        }
+
+        if (marker == CAM_JPEG_SOS)
+        {
+            if (index->scan == 0)
+            {
+                index->scan = pos;
+            }
+            while ((pos = CAM_jpeg_find_ff(data, pos, length)) < (length - 1))
+            {
+                marker = data[pos + 1];
+                if ((marker == 0x00) || (marker == 0xFF))
+                {
+                    pos += (marker == 0x00) ? 2 : 1;
+                }
+                else if ((marker & 0xF8) == CAM_JPEG_RST0)
+                {
+                    CAM_jpeg_add(index, pos, marker);
+                    index->restarts++;
+                    pos += 2;
+                }
+                else
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    // Ran out of data before the end of image
+    return OS_ERROR;
+}
+
+/************************/
+/*  End of File Comment */
+/************************/
@@ -0,0 +1,71 @@
+/* Copyright (C) 2009 - 2017 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S.
+Government.
+
+This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including,
+but not limited to, any warranty that the software will conform to, specifications any implied warranties of
+merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+documentation will conform to the program, or any warranty that the software will be error free.
+
+In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+consequential damages, arising out of, resulting from, or in any way connected with the software or its documentation.
+Whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained from, or arose
+out of the results of, or use of, the software, documentation or services provided hereunder
+
+ITC Team
+NASA IV&V
+ivv-itc@lists.nasa.gov
+*/
+
+#ifndef _cam_jpeg_h_
+#define _cam_jpeg_h_
+
+#include "device_cfg.h"
+#include "hwlib.h"
+#include "cam_platform_cfg.h"
+
+/************************************************************************
+** JPEG Marker Definitions
+*************************************************************************/
+#define CAM_JPEG_SOF0 0xC0 // Baseline frame, SOF1 to SOF15 follow except DHT/JPG/DAC
+#define CAM_JPEG_DHT  0xC4
+#define CAM_JPEG_RST0 0xD0 // RST0 to RST7 are 0xD0 to 0xD7
+#define CAM_JPEG_SOI  0xD8
+#define CAM_JPEG_EOI  0xD9
+#define CAM_JPEG_SOS  0xDA
+#define CAM_JPEG_DQT  0xDB
+#define CAM_JPEG_DRI  0xDD
+
+/*
+** One marker, offset is that of its 0xFF
+*/
+typedef struct
+{
+    uint32_t offset;
+    uint8_t  marker;
+} CAM_Jpeg_Marker_t;
+
+/*
+** Markers of one frame in RAM. Only the first CAM_JPEG_MAX_MARKERS are kept,
+** restarts counts every RSTn so restart intervals can be located past that.
+*/
+typedef struct
+{
+    CAM_Jpeg_Marker_t markers[CAM_JPEG_MAX_MARKERS];
+    uint16_t          count;            /* Markers kept */
+    uint16_t          restart_interval; /* MCUs between restarts from DRI, 0 for none */
+    uint32_t          restarts;         /* RSTn markers in the scans */
+    uint32_t          scan;             /* Offset of the first entropy coded byte */
+    uint32_t          length;           /* Bytes through EOI, anything after is FIFO garbage */
+} CAM_Jpeg_Index_t;
+
+/*************************************************************************
+** Exported Functions
+*************************************************************************/
+extern uint32_t CAM_jpeg_find_marker(uint8_t last, const uint8_t *data, uint32_t length, uint8_t marker);
+extern int32_t  CAM_jpeg_index(const uint8_t *data, uint32_t length, CAM_Jpeg_Index_t *index);
+
+#endif /* _cam_jpeg_h_ */
+
+/************************/
+/*  End of File Comment */
+/************************/
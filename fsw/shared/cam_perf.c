@@ -0,0 +1,116 @@
+/* Copyright (C) 2009 - 2017 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S.
+Government.
+
+This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including,
+but not limited to, any warranty that the software will conform to, specifications any implied warranties of
+merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+documentation will conform to the program, or any warranty that the software will be error free.
+
+In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+consequential damages, arising out of, resulting from, or in any way connected with the software or its documentation.
+Whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained from, or arose
+out of the results of, or use of, the software, documentation or services provided hereunder
+
+ITC Team
+NASA IV&V
+ivv-itc@lists.nasa.gov
+*/
+
+/*******************************************************************************
+** File: cam_perf.c
+**
+** Purpose:
+**   Timing counters behind the performance markers when there is no cFE.
+**
+*******************************************************************************/
+
+/*************************************************************************
+** Includes
+*************************************************************************/
+#include "device_cfg.h"
+#include "cam_perf.h"
+
+#include <string.h>
+#include <time.h>
+
+/*************************************************************************
+** Global Data
+*************************************************************************/
+CAM_Perf_t CAM_Perf[CAM_PERF_MARKERS];
+
+/*************************************************************************
+** Private Data
+*************************************************************************/
+static const char *CAM_Perf_Names[CAM_PERF_MARKERS] = {
+    "app",          "child task", "downlink task", "I2C init",  "SPI init",   "registers",
+    "capture prep", "capture",    "FIFO length",   "read prep", "FIFO chunk", "publish",
+    "drain chunk",
+};
+
+static uint64_t CAM_perf_now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000) + (ts.tv_nsec / 1000);
+}
+
+void CAM_perf_entry(uint32_t id)
+{
+    if ((id >= CAM_PERF_ID) && (id <= CAM_PERF_LAST_ID))
+    {
+        CAM_Perf[id - CAM_PERF_ID].start_us = CAM_perf_now_us();
+    }
+}
+
+void CAM_perf_exit(uint32_t id)
+{
+    CAM_Perf_t *perf;
+    uint32_t    elapsed;
+
+    if ((id < CAM_PERF_ID) || (id > CAM_PERF_LAST_ID))
+    {
+        return;
+    }
+
+    // An exit without an entry, e.g. after a reset, is not counted
+    perf = &CAM_Perf[id - CAM_PERF_ID];
+    if (perf->start_us == 0)
+    {
+        return;
+    }
+    elapsed        = (uint32_t)(CAM_perf_now_us() - perf->start_us);
+    perf->start_us = 0;
+    perf->count++;
+    perf->last_us = elapsed;
+    perf->total_us += elapsed;
+    if (elapsed > perf->max_us)
+    {
+        perf->max_us = elapsed;
+    }
+}
+
+void CAM_perf_reset(void)
+{
+    memset(CAM_Perf, 0, sizeof(CAM_Perf));
+}
+
+void CAM_perf_report(void)
+{
+    uint32_t n;
+
+    OS_printf("%-14s %8s %12s %10s %10s\n", "marker", "count", "total_us", "mean_us", "max_us");
+    for (n = 0; n < CAM_PERF_MARKERS; n++)
+    {
+        if (CAM_Perf[n].count > 0)
+        {
+            OS_printf("%-14s %8u %12llu %10llu %10u\n", CAM_Perf_Names[n], CAM_Perf[n].count,
+                      (unsigned long long)CAM_Perf[n].total_us,
+                      (unsigned long long)(CAM_Perf[n].total_us / CAM_Perf[n].count), CAM_Perf[n].max_us);
+        }
+    }
+}
+
+/************************/
+/*  End of File Comment */
+/************************/
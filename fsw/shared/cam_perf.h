@@ -0,0 +1,72 @@
+/* Copyright (C) 2009 - 2017 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S.
+Government.
+
+This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including,
+but not limited to, any warranty that the software will conform to, specifications any implied warranties of
+merchantability, fitness for a particular purpose, and freedom from infringement, and any warranty that the
+documentation will conform to the program, or any warranty that the software will be error free.
+
+In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or
+consequential damages, arising out of, resulting from, or in any way connected with the software or its documentation.
+Whether or not based upon warranty, contract, tort or otherwise, and whether or not loss was sustained from, or arose
+out of the results of, or use of, the software, documentation or services provided hereunder
+
+ITC Team
+NASA IV&V
+ivv-itc@lists.nasa.gov
+*/
+
+#ifndef _cam_perf_h_
+#define _cam_perf_h_
+
+#include "hwlib.h"
+#include "cam_perfids.h"
+
+/************************************************************************
+** Performance Markers
+*************************************************************************/
+/*
+** The driver brackets each capture stage with CAM_PERF_ENTRY/EXIT on the IDs
+** in cam_perfids.h. The cFS build defines CAM_PERF_CFE so they go to the cFE
+** performance monitor, other builds keep timing counters in CAM_Perf instead.
+*/
+#ifdef CAM_PERF_CFE
+#include "cfe.h"
+
+#define CAM_PERF_ENTRY(id) CFE_ES_PerfLogEntry(id)
+#define CAM_PERF_EXIT(id)  CFE_ES_PerfLogExit(id)
+#else
+
+#define CAM_PERF_MARKERS (CAM_PERF_LAST_ID - CAM_PERF_ID + 1)
+
+/*
+** Timing of one marker since the last reset, in microseconds
+*/
+typedef struct
+{
+    uint32_t count;
+    uint32_t last_us;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint64_t start_us; /* Set on entry, 0 when not inside the marker */
+} CAM_Perf_t;
+
+extern CAM_Perf_t CAM_Perf[CAM_PERF_MARKERS];
+
+/*************************************************************************
+** Exported Functions
+*************************************************************************/
+extern void CAM_perf_entry(uint32_t id);
+extern void CAM_perf_exit(uint32_t id);
+extern void CAM_perf_reset(void);
+extern void CAM_perf_report(void);
+
+#define CAM_PERF_ENTRY(id) CAM_perf_entry(id)
+#define CAM_PERF_EXIT(id)  CAM_perf_exit(id)
+#endif
+
+#endif /* _cam_perf_h_ */
+
+/************************/
+/*  End of File Comment */
+/************************/
@@ -20,9 +20,25 @@ ivv-itc@lists.nasa.gov
 #define _CAM_PERFIDS_H_
 
 /*
-** CAM performance IDs
+** CAM performance IDs, shared by the cFS and F Prime builds
 */
-#define CAM_PERF_ID            105
-#define CAM_CHILD_TASK_PERF_ID 106
+#define CAM_PERF_ID               105
+#define CAM_CHILD_TASK_PERF_ID    106
+#define CAM_DOWNLINK_TASK_PERF_ID 107
+
+/*
+** Capture pipeline stages, see fsw/shared/cam_perf.h
+*/
+#define CAM_I2C_INIT_PERF_ID     108 // CAM_init_i2c
+#define CAM_SPI_INIT_PERF_ID     109 // CAM_init_spi
+#define CAM_REGS_PERF_ID         110 // Each sensor register table written
+#define CAM_CAPTURE_PREP_PERF_ID 111 // Flush the FIFO and start a capture
+#define CAM_CAPTURE_PERF_ID      112 // Wait for capture done
+#define CAM_FIFO_LENGTH_PERF_ID  113 // CAM_read_fifo_length
+#define CAM_READ_PREP_PERF_ID    114 // Seek the FIFO to the JPEG header
+#define CAM_FIFO_CHUNK_PERF_ID   115 // Each piece CAM_read clocks out of the FIFO
+#define CAM_PUBLISH_PERF_ID      116 // Each experiment packet sent
+#define CAM_DRAIN_CHUNK_PERF_ID  117 // Each chunk a burst drain clocks out of the FIFO
+#define CAM_PERF_LAST_ID         CAM_DRAIN_CHUNK_PERF_ID
 
 #endif
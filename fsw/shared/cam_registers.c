@@ -1373,6 +1373,7 @@ int32_t CAM_jpeg_init(void)
     result = arducam_i2c_write_regs(ov5642_dvp_fmt_global_init);
     OS_TaskDelay(100);
 #endif
+    CAM_session_mark(CAM_STAGE_JPEG_INIT, result);
     return result;
 }
 
@@ -1388,6 +1389,7 @@ int32_t CAM_yuv422(void)
 #ifdef OV5642
     OS_TaskDelay(100);
 #endif
+    CAM_session_mark(CAM_STAGE_YUV422, result);
     return result;
 }
 
@@ -1410,6 +1412,7 @@ int32_t CAM_jpeg(void)
 #ifdef OV5642
     result = arducam_i2c_write_regs(ov5642_dvp_fmt_jpeg_qvga);
 #endif
+    CAM_session_mark(CAM_STAGE_JPEG, result);
     return result;
 }
 
@@ -1483,29 +1486,51 @@ int32_t CAM_setSize(uint8_t size)
     // Let auto exposure do it's thing
     OS_TaskDelay(1000);
 
+    CAM_Session.size = size;
+    CAM_session_mark(CAM_STAGE_SIZE, result);
     return result;
 }
 
+/*
+** Yield policy for register programming, called once per I2C transaction
+*/
+static void arducam_i2c_yield(uint32_t *transactions)
+{
+    (*transactions)++;
+#if (CAM_I2C_YIELD_EVERY > 0)
+    if ((*transactions % CAM_I2C_YIELD_EVERY) == 0)
+    {
+        OS_TaskDelay(CAM_I2C_YIELD_DELAY); // Let other processes run
+    }
+#endif
+}
+
 static int32_t arducam_i2c_write_regs(struct sensor_reg reglist[])
 {
     int32_t            result = OS_SUCCESS;
     struct sensor_reg *next   = reglist;
+    uint32_t           transactions = 0;
+    uint32_t           registers    = 0;
 #ifdef OV2640
     uint8_t test[2];
 #endif
 #if (defined(OV5640) || defined(OV5642))
-    uint8_t test[3];
+    uint8_t  test[2 + CAM_I2C_BURST_SIZE];
+    uint16_t start;
+    uint8_t  count;
 #endif
     int32_t errors = 0;
 
+    CAM_PERF_ENTRY(CAM_REGS_PERF_ID);
+
 #ifdef OV2640
     while ((next->reg != 0xFF) || (next->val != 0xFF))
     {
         test[0] = next->reg;
         test[1] = next->val;
         result  = i2c_master_transaction(&CAM_I2C, CAM_ADDR, &test, 2, NULL, 0, CAM_TIMEOUT);
-        OS_TaskDelay(1);  // Let other processes run
-        if (result != -1) // OS_SUCCESS
+        arducam_i2c_yield(&transactions);
+        if (result != OS_SUCCESS)
         {
             errors++;
         }
@@ -1519,53 +1544,71 @@ static int32_t arducam_i2c_write_regs(struct sensor_reg reglist[])
             OS_printf("----- arducam_i2c_write_regs: error on config check \n");
         }
         */
+        registers++;
         next++;
     }
 #endif
 #if (defined(OV5640) || defined(OV5642))
     while ((next->reg != 0xFFFF) || (next->val != 0xFF))
     {
-        test[0] = (next->reg & 0xFF00) >> 8;
-        test[1] = next->reg & 0x00FF;
-        test[2] = next->val;
-
-        // OS_printf("test[0] = 0x%02x; test[1] = 0x%02x; test[2] = 0x%02x; \n", test[0],test[1],test[2]);
-
-        result = i2c_master_transaction(&CAM_I2C, CAM_ADDR, &test, 3, NULL, 0, CAM_TIMEOUT);
-        OS_TaskDelay(1); // Let other processes run
-        if (result != OS_SUCCESS)
+        // Coalesce a run of consecutive addresses into one auto-increment write
+        start   = next->reg;
+        count   = 0;
+        test[0] = (start & 0xFF00) >> 8;
+        test[1] = start & 0x00FF;
+        do
         {
-            errors++;
+            test[2 + count] = next->val;
+            count++;
+            next++;
+            // A system control write (e.g. software reset) always ends its transaction
+            if ((start + count - 1) == SYSTEM_CTRL)
+            {
+                break;
+            }
+        } while ((count < CAM_I2C_BURST_SIZE) && (next->reg == (uint16_t)(start + count)) &&
+                 ((next->reg != 0xFFFF) || (next->val != 0xFF)));
+
+        // OS_printf("reg = 0x%04x; count = %d; \n", start, count);
+
+        result = i2c_master_transaction(&CAM_I2C, CAM_ADDR, &test, 2 + count, NULL, 0, CAM_TIMEOUT);
+        registers += count;
+        if (((start + count - 1) == SYSTEM_CTRL) && (test[1 + count] & 0x80))
+        {
+            // Software reset, the rest of the table has to wait for the sensor to come back
+            transactions++;
+            OS_TaskDelay(CAM_RESET_SETTLE);
         }
-
-        // Check that register was written properly
-        /*
-        test[2] = 0xFF;
-        result = i2c_master_transaction(&CAM_I2C, CAM_ADDR, &test, 2, &test[2], 1, CAM_TIMEOUT);
-        if (test[2] != next->val)
+        else
         {
-            OS_printf("----- arducam_i2c_write_regs: error on config check \n");
+            arducam_i2c_yield(&transactions);
+        }
+        if (result != OS_SUCCESS)
+        {
+            errors++;
         }
-        */
-        next++;
     }
 #endif
 
 #ifdef STF1_DEBUG
+    OS_printf("CAM_LIB: arducam_i2c_write_regs wrote %u registers in %u transactions \n", (unsigned int)registers,
+              (unsigned int)transactions);
     if (errors > 0)
     {
-        OS_printf("CAM_LIB: arducam_i2c_write_regs had %ld errors!", errors);
+        OS_printf("CAM_LIB: arducam_i2c_write_regs had %d errors!", (int)errors);
     }
 #endif
 
     // Change to preferred OS_SUCCESS
     if (errors <= 10)
     {
+        CAM_Stats.i2c_errors += errors;
         result = OS_SUCCESS;
     }
     else
     {
         result = OS_ERROR;
     }
+    CAM_PERF_EXIT(CAM_REGS_PERF_ID);
     return result;
 }
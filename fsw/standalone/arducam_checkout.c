@@ -30,6 +30,11 @@ void print_help(void)
                   "small                              - Request small image             \n"
                   "medium                             - Request medium image            \n"
                   "large                              - Request large image             \n"
+                  "perf                               - Report and reset stage timing   \n"
+#ifdef CAM_BUS_TRACE
+                  "trace file                         - Record bus calls to a trace     \n"
+                  "trace stop                         - Stop recording                  \n"
+#endif
                   "\n");
 }
 
@@ -86,6 +91,16 @@ int get_command(const char *str)
     {
         status = CMD_LARGE;
     }
+    else if (strcmp(lcmd, "perf") == 0)
+    {
+        status = CMD_PERF;
+    }
+#ifdef CAM_BUS_TRACE
+    else if (strcmp(lcmd, "trace") == 0)
+    {
+        status = CMD_TRACE;
+    }
+#endif
     return status;
 }
 
@@ -207,6 +222,31 @@ int process_command(int cc, int num_tokens, char tokens[MAX_INPUT_TOKENS][MAX_IN
             }
             break;
 
+        case CMD_PERF:
+            if (check_number_arguments(num_tokens, 0) == OS_SUCCESS)
+            {
+                CAM_perf_report();
+                CAM_perf_reset();
+            }
+            break;
+
+#ifdef CAM_BUS_TRACE
+        case CMD_TRACE:
+            if (check_number_arguments(num_tokens, 1) == OS_SUCCESS)
+            {
+                if (strcmp(tokens[0], "stop") == 0)
+                {
+                    CAM_bus_stop();
+                    OS_printf("Trace stopped\n");
+                }
+                else if (CAM_bus_record(tokens[0]) == OS_SUCCESS)
+                {
+                    OS_printf("Recording bus calls to %s\n", tokens[0]);
+                }
+            }
+            break;
+#endif
+
         default:
             OS_printf("Invalid command format, type 'help' for more info\n");
             break;
@@ -265,6 +305,7 @@ int main(int argc, char *argv[])
     }
 
     // Close the device(s)
+    CAM_bus_stop();
     i2c_master_close(&CAM_I2C);
     spi_close_device(&CAM_SPI);
 
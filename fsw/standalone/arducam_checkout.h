@@ -53,6 +53,8 @@
 #define CMD_SMALL   5
 #define CMD_MEDIUM  6
 #define CMD_LARGE   7
+#define CMD_TRACE   8
+#define CMD_PERF    9
 
 /*
 ** Prototypes
@@ -0,0 +1,81 @@
+/* Copyright (C) 2016 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#ifndef NOS3_CAMARDUCHIPMODEL_HPP
+#define NOS3_CAMARDUCHIPMODEL_HPP
+
+#include <cstdint>
+
+namespace Nos3
+{
+    /*
+    ** ArduChip SPI register map. Each register in the table has its access checked,
+    ** anything outside it is reserved. Capture and FIFO contents are driven by the
+    ** hardware model, this keeps the values and how they read back.
+    */
+    class CamArduChipModel
+    {
+    public:
+        enum Register
+        {
+            TEST            = 0x00,
+            CAPTURE_CONTROL = 0x01, // Frames to capture minus one [2:0]
+            MODE            = 0x02,
+            TIMING          = 0x03,
+            FIFO_CONTROL    = 0x04,
+            GPIO_DIRECTION  = 0x05,
+            GPIO_WRITE      = 0x06,
+            RESET           = 0x07,
+            BURST_FIFO_READ = 0x3C,
+            FIFO_READ       = 0x3D,
+            VERSION         = 0x40,
+            STATUS          = 0x41,
+            FIFO_SIZE_LOW   = 0x42, // [7:0]
+            FIFO_SIZE_MID   = 0x43, // [15:8]
+            FIFO_SIZE_HIGH  = 0x44, // [22:16]
+            GPIO_READ       = 0x45
+        };
+
+        // FIFO control bits
+        static const std::uint8_t FIFO_CLEAR_DONE = 0x01;
+        static const std::uint8_t FIFO_START      = 0x02;
+        static const std::uint8_t FIFO_RESET_WRITE = 0x10;
+        static const std::uint8_t FIFO_RESET_READ = 0x20;
+
+        static const std::uint32_t FIFO_LENGTH_MASK = 0x7FFFFF;
+
+        CamArduChipModel(std::uint8_t version);
+        void reset(void);
+        bool write(std::uint8_t reg, std::uint8_t value);
+        bool read(std::uint8_t reg, std::uint8_t& value) const;
+        void set_capture_done(bool done);
+        void set_fifo_length(std::uint32_t length);
+        void set_fifo_data(std::uint8_t value) {_fifo_data = value;}
+        std::uint32_t fifo_length(void) const {return _fifo_length;}
+        std::uint8_t fifo_data(void) const {return _fifo_data;}
+        std::uint8_t frames(void) const {return (_registers[CAPTURE_CONTROL] & 0x07) + 1;}
+        static const char* name(std::uint8_t reg);
+    private:
+        std::uint8_t  _registers[0x80]; // Seven bit address, the top bit of the command selects write
+        std::uint8_t  _version;
+        std::uint8_t  _status;
+        std::uint8_t  _fifo_data;
+        std::uint32_t _fifo_length;
+    };
+}
+
+#endif
@@ -20,14 +20,32 @@
 
 #include <sim_i_data_point.hpp>
 
+#include <boost/shared_ptr.hpp>
+
+#include <cstdint>
+#include <vector>
+
 namespace Nos3
 {
+    // JPEG bytes shared between the provider cache and the FIFO serving them
+    typedef boost::shared_ptr<const std::vector<std::uint8_t>> CamImage;
+
     class CamDataPoint : public SimIDataPoint
     {
     public:
         CamDataPoint(void);
+        CamDataPoint(const std::string& name, std::uint16_t width, std::uint16_t height, CamImage image);
         ~CamDataPoint(void);
         std::string to_string(void) const;
+        const std::string& get_name(void) const {return _name;}
+        std::uint16_t get_width(void) const {return _width;}
+        std::uint16_t get_height(void) const {return _height;}
+        CamImage get_image(void) const {return _image;}
+    private:
+        std::string   _name;
+        std::uint16_t _width;
+        std::uint16_t _height;
+        CamImage      _image;
     };
 }
 
@@ -19,15 +19,53 @@
 #define NOS3_CAMDATAPROVIDER_HPP
 
 #include <sim_i_data_provider.hpp>
+#include <cam_data_point.hpp>
+#include <cam_jpeg_generator.hpp>
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
 
 namespace Nos3
 {
+    /*
+    ** Serves JPEGs from a directory, indexed by the resolution in their SOF header.
+    ** Each capture takes the next frame for the size the sensor was configured for,
+    ** frames read from disk are kept in a cache bounded to the least recently used.
+    ** Sizes with no frames on disk can be served a generated JPEG instead.
+    */
     class CamDataProvider : public SimIDataProvider
     {
     public:
         CamDataProvider(const boost::property_tree::ptree& config);
         ~CamDataProvider(void);
         boost::shared_ptr<SimIDataPoint> get_data_point(void) const;
+        boost::shared_ptr<CamDataPoint> next_frame(std::uint16_t width, std::uint16_t height);
+        static bool jpeg_size(const std::string& path, std::uint16_t& width, std::uint16_t& height);
+    private:
+        typedef std::uint32_t Resolution; // width << 16 | height
+        struct CacheEntry
+        {
+            CamImage                         image;
+            std::list<std::string>::iterator lru;
+        };
+        void index_directory(const std::string& directory);
+        CamImage load(const std::string& path);
+
+        std::map<Resolution, std::vector<std::string>> _library; // Files of each resolution, in name order
+        std::map<Resolution, size_t>                   _next;    // Next file of each resolution to serve
+        std::map<std::string, CacheEntry>              _cache;
+        std::list<std::string>                         _lru;     // Most recently used first
+        size_t                                         _cache_size;
+        bool                                           _synthetic;
+        size_t                                         _synthetic_bytes; // 0 is one byte per 8 pixels
+        std::uint32_t                                  _synthetic_seed;
+        CamJpegGenerator                               _generator;
+        boost::shared_ptr<CamDataPoint>                _last;
+        mutable std::mutex                             _mutex;
     };
 }
 
@@ -20,34 +20,81 @@
 
 #include <sim_i_hardware_model.hpp>
 #include <Client/Bus.hpp>
+#include <cam_arduchip_model.hpp>
+#include <cam_data_point.hpp>
+#include <cam_sensor_model.hpp>
+#include <cam_timing_model.hpp>
 
 // Protocols
 #include <I2C/Client/I2CSlave.hpp>
 #include <Spi/Client/SpiSlave.hpp>
 
 #include <atomic>
-#include <fstream>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
 
 namespace Nos3
 {
     class CamHardwareModel : public SimIHardwareModel
     {
     public:
+        // Faults injected from the command bus
+        static const std::uint8_t FAULT_I2C     = 0x01; // Sensor stops answering
+        static const std::uint8_t FAULT_CAPTURE = 0x02; // Capture never completes
+        static const std::uint8_t FAULT_FIFO    = 0x04; // Second half of each frame reads as zeros
+
+
         CamHardwareModel(const boost::property_tree::ptree& config);
         ~CamHardwareModel(void);
         void run(void);
-        std::uint8_t determine_i2c_response_for_request(const std::vector<uint8_t>& in_data); 
-        std::uint16_t determine_spi_response_for_request(const std::vector<uint8_t>& in_data); 
+        std::uint8_t determine_i2c_response_for_request(const std::uint8_t *in_data, size_t len);
+        std::uint16_t determine_spi_response_for_request(const std::uint8_t *in_data, size_t len);
+        bool burst_read_active(void) const;
+        void read_fifo_burst(std::uint8_t *rbuf, size_t rlen);
+        void spi_transfer(size_t bytes);
+        void i2c_transfer(size_t bytes);
         void command_callback(NosEngine::Common::Message msg);
     private:
+        static CamSensorModel::Sensor sensor_type(const boost::property_tree::ptree& config);
+        void time_tick(NosEngine::Common::SimTime time);
+        void execute(const std::string& command);
+        CamImage load_image(const std::string& path);
+        void start_capture(void);
+        void fifo_next(void);
+        void fifo_rewind(void);
+        double now_us(void) const;
+        void bus_wait(double& free_at, double us);
+        bool capture_done(void) const;
         std::atomic<bool>                       _keep_running;
         SimIDataProvider*                       _sdp;
+        class CamDataProvider*                  _cam_dp;   // Same provider when it is an image library
+        // Declared ahead of the time bus so they outlive its tick callback, which uses them
+        std::mutex                              _mutex;    // Commands, faults and the default image
+        std::condition_variable                 _wake;
+        std::condition_variable                 _tick;     // Bus transfers waiting for sim time
+        int                                     _bus_waiters;
         std::unique_ptr<NosEngine::Client::Bus> _time_bus;
         class I2CSlaveConnection*               _i2c_slave_connection;
         class SpiSlaveConnection*               _spi_slave_connection;
-        std::uint8_t                            spi_register[69]; // 0x45
-        std::ifstream                           fin;
-        std::uint32_t                           fifo_length;
+        CamArduChipModel                        _arduchip;      // SPI registers
+        CamImage                                _default_image; // Loaded once, served when the library has no match
+        CamImage                                _image;         // Image of the current capture
+        size_t                                  _fifo_pos;      // Next image byte the FIFO hands out
+        CamSensorModel                          _sensor;        // Registers written over I2C
+        bool                                    _burst_read;
+        bool                                    _capture_done;
+        std::uint8_t                            _frames_left;
+        CamTimingModel                          _timing;
+        double                                  _capture_done_at; // Sim time the FIFO is full, microseconds
+        double                                  _spi_free_at;     // Sim time the last SPI transfer ends
+        double                                  _i2c_free_at;     // Sim time the last I2C transfer ends
+        std::deque<std::string>                 _commands;        // Run by the run loop in order
+        std::atomic<std::uint8_t>               _faults;
+        double                                  _fault_until;     // Sim time faults clear, 0 when they stay
+        bool                                    _fault_expired;
     };
 
     class I2CSlaveConnection : public NosEngine::I2C::I2CSlave
@@ -0,0 +1,48 @@
+/* Copyright (C) 2016 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#ifndef NOS3_CAMJPEGGENERATOR_HPP
+#define NOS3_CAMJPEGGENERATOR_HPP
+
+#include <cam_data_point.hpp>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace Nos3
+{
+    /*
+    ** Builds valid baseline grayscale JPEGs of any dimension and close to a target size.
+    ** The scan is random coefficients from a seeded generator, so the same request
+    ** always gives the same bytes. Sizes past what the scan can hold are made up
+    ** with comment segments.
+    */
+    class CamJpegGenerator
+    {
+    public:
+        CamImage get(std::uint16_t width, std::uint16_t height, size_t target_bytes, std::uint32_t seed);
+        static CamImage generate(std::uint16_t width, std::uint16_t height, size_t target_bytes, std::uint32_t seed);
+    private:
+        typedef std::tuple<std::uint16_t, std::uint16_t, size_t, std::uint32_t> Key;
+        std::map<Key, CamImage> _cache;
+        std::mutex              _mutex;
+    };
+}
+
+#endif
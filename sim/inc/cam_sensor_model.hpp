@@ -0,0 +1,81 @@
+/* Copyright (C) 2016 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#ifndef NOS3_CAMSENSORMODEL_HPP
+#define NOS3_CAMSENSORMODEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace Nos3
+{
+    /*
+    ** Sensor register file with only the registers written kept. The OV5640 and OV5642
+    ** use 16-bit addresses, the OV2640 8-bit addresses in two banks selected by 0xFF.
+    ** Reads of registers never written return 0, the chip ID is fixed.
+    ** Output size and format are decoded from what the flight software programmed.
+    */
+    class CamSensorModel
+    {
+    public:
+        enum Format
+        {
+            FORMAT_RAW,
+            FORMAT_RGB,
+            FORMAT_YUV,
+            FORMAT_JPEG
+        };
+
+        enum Sensor
+        {
+            OV2640,
+            OV5640,
+            OV5642
+        };
+
+        CamSensorModel(Sensor sensor);
+        static bool parse(const std::string& name, Sensor& sensor);
+        static const char* sensor_name(Sensor sensor);
+        Sensor sensor(void) const {return _sensor;}
+        std::uint8_t i2c_address(void) const {return (_sensor == OV2640) ? 0x30 : 0x3C;}
+        size_t address_bytes(void) const {return (_sensor == OV2640) ? 1 : 2;}
+        void reset(void);
+        std::uint8_t read(std::uint16_t reg) const;
+        void write(std::uint16_t reg, std::uint8_t value);
+        std::uint16_t output_width(void) const;
+        std::uint16_t output_height(void) const;
+        Format output_format(void) const;
+        static const char* format_name(Format format);
+        size_t writes(void) const {return _writes;}
+        size_t redundant_writes(void) const {return _redundant;}
+        size_t registers(void) const {return _registers.size();}
+    private:
+        std::uint16_t key(std::uint16_t reg) const;
+        std::uint8_t stored(std::uint16_t index) const;
+        bool chip_id(std::uint16_t reg, std::uint8_t& value) const;
+
+        Sensor                                          _sensor;
+        std::uint8_t                                    _bank;      // OV2640 register bank, 0 DSP and 1 sensor
+        std::unordered_map<std::uint16_t, std::uint8_t> _registers; // Keyed by bank and address on the OV2640
+        size_t                                          _writes;    // Since the last reset
+        size_t                                          _redundant; // Writes of the value already held
+    };
+}
+
+#endif
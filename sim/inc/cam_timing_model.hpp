@@ -0,0 +1,53 @@
+/* Copyright (C) 2016 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#ifndef NOS3_CAMTIMINGMODEL_HPP
+#define NOS3_CAMTIMINGMODEL_HPP
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace Nos3
+{
+    /*
+    ** How long the camera takes, in simulated microseconds: exposure for each resolution,
+    ** filling the FIFO, and moving bytes over SPI and I2C. Everything is zero unless
+    ** simulator.hardware-model.timing.enabled is set, which keeps the old behavior.
+    */
+    class CamTimingModel
+    {
+    public:
+        CamTimingModel(const boost::property_tree::ptree& config);
+        bool enabled(void) const {return _enabled;}
+        void set_exposure_us(double us);
+        double capture_us(std::uint16_t width, std::uint16_t height, size_t bytes) const;
+        double spi_us(size_t bytes) const;
+        double i2c_us(size_t bytes) const;
+    private:
+        bool                                 _enabled;
+        double                               _exposure_us;     // Resolutions not listed
+        std::map<std::uint32_t, double>      _exposures_us;    // width << 16 | height
+        double                               _fifo_fill_rate;  // Bytes per second into the FIFO
+        double                               _spi_clock;       // Hz, CAM_SPEED in the flight software
+        double                               _i2c_byte_us;     // Per byte, address and ack included
+    };
+}
+
+#endif
@@ -0,0 +1,172 @@
+/* Copyright (C) 2016 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#include <cam_arduchip_model.hpp>
+
+#include <ItcLogger/Logger.hpp>
+
+#include <cstring>
+
+namespace Nos3
+{
+    extern ItcLogger::Logger *sim_logger;
+
+    namespace
+    {
+        enum Access
+        {
+            RESERVED   = 0,
+            READ       = 1,
+            WRITE      = 2,
+            READ_WRITE = 3
+        };
+
+        struct RegisterSpec
+        {
+            std::uint8_t address;
+            Access       access;
+            const char*  name;
+        };
+
+        const RegisterSpec REGISTERS[] =
+        {
+            {CamArduChipModel::TEST,            READ_WRITE, "test"},
+            {CamArduChipModel::CAPTURE_CONTROL, READ_WRITE, "capture control"},
+            {CamArduChipModel::MODE,            READ_WRITE, "mode"},
+            {CamArduChipModel::TIMING,          READ_WRITE, "sensor interface timing"},
+            {CamArduChipModel::FIFO_CONTROL,    WRITE,      "FIFO control"},
+            {CamArduChipModel::GPIO_DIRECTION,  READ_WRITE, "GPIO direction"},
+            {CamArduChipModel::GPIO_WRITE,      READ_WRITE, "GPIO write"},
+            {CamArduChipModel::RESET,           WRITE,      "reset"},
+            {CamArduChipModel::BURST_FIFO_READ, READ,       "burst FIFO read"},
+            {CamArduChipModel::FIFO_READ,       READ,       "single FIFO read"},
+            {CamArduChipModel::VERSION,         READ,       "version"},
+            {CamArduChipModel::STATUS,          READ,       "status"},
+            {CamArduChipModel::FIFO_SIZE_LOW,   READ,       "FIFO size [7:0]"},
+            {CamArduChipModel::FIFO_SIZE_MID,   READ,       "FIFO size [15:8]"},
+            {CamArduChipModel::FIFO_SIZE_HIGH,  READ,       "FIFO size [22:16]"},
+            {CamArduChipModel::GPIO_READ,       READ,       "GPIO read"},
+        };
+
+        const RegisterSpec* find(std::uint8_t reg)
+        {
+            for (const RegisterSpec& spec : REGISTERS)
+            {
+                if (spec.address == reg)
+                {
+                    return &spec;
+                }
+            }
+            return nullptr;
+        }
+    }
+
+    CamArduChipModel::CamArduChipModel(std::uint8_t version) : _version(version)
+    {
+        reset();
+    }
+
+    void CamArduChipModel::reset(void)
+    {
+        memset(_registers, 0, sizeof(_registers));
+        _status = 0;
+        _fifo_data = 0;
+        _fifo_length = 0;
+    }
+
+    bool CamArduChipModel::write(std::uint8_t reg, std::uint8_t value)
+    {
+        const RegisterSpec* spec = find(reg & 0x7F);
+
+        if ((spec == nullptr) || !(spec->access & WRITE))
+        {
+            sim_logger->error("CamArduChipModel::write:  ERROR - write of 0x%02x to %s register 0x%02x!", value,
+                (spec == nullptr) ? "reserved" : "read only", reg);
+            return false;
+        }
+        if ((reg == RESET) && (value & 0x80))
+        {
+            reset();
+            return true;
+        }
+        _registers[reg] = value;
+        return true;
+    }
+
+    bool CamArduChipModel::read(std::uint8_t reg, std::uint8_t& value) const
+    {
+        const RegisterSpec* spec = find(reg & 0x7F);
+
+        value = 0x00;
+        if ((spec == nullptr) || !(spec->access & READ))
+        {
+            sim_logger->error("CamArduChipModel::read:  ERROR - read of %s register 0x%02x!",
+                (spec == nullptr) ? "reserved" : "write only", reg);
+            return false;
+        }
+        switch (reg)
+        {
+            case BURST_FIFO_READ:
+            case FIFO_READ:
+                value = _fifo_data;
+                break;
+            case VERSION:
+                value = _version;
+                break;
+            case STATUS:
+                value = _status;
+                break;
+            case FIFO_SIZE_LOW:
+                value = _fifo_length & 0xFF;
+                break;
+            case FIFO_SIZE_MID:
+                value = (_fifo_length >> 8) & 0xFF;
+                break;
+            case FIFO_SIZE_HIGH:
+                value = (_fifo_length >> 16) & 0x7F;
+                break;
+            case GPIO_READ:
+                value = _registers[GPIO_WRITE] & 0x07; // Reset, power down and power enable lines
+                break;
+            default:
+                value = _registers[reg];
+                break;
+        }
+        return true;
+    }
+
+    void CamArduChipModel::set_capture_done(bool done)
+    {
+        _status = done ? (_status | 0x08) : (_status & ~0x08);
+    }
+
+    void CamArduChipModel::set_fifo_length(std::uint32_t length)
+    {
+        if (length > FIFO_LENGTH_MASK)
+        {
+            sim_logger->warning("CamArduChipModel::set_fifo_length:  %u bytes is more than the FIFO holds", length);
+            length = FIFO_LENGTH_MASK;
+        }
+        _fifo_length = length;
+    }
+
+    const char* CamArduChipModel::name(std::uint8_t reg)
+    {
+        const RegisterSpec* spec = find(reg & 0x7F);
+        return (spec != nullptr) ? spec->name : "reserved";
+    }
+}
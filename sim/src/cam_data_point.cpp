@@ -19,11 +19,19 @@
 
 #include <ItcLogger/Logger.hpp>
 
+#include <sstream>
+
 namespace Nos3
 {
     extern ItcLogger::Logger *sim_logger;
 
-    CamDataPoint::CamDataPoint(void) : SimIDataPoint()
+    CamDataPoint::CamDataPoint(void) : SimIDataPoint(), _width(0), _height(0)
+    {
+        sim_logger->trace("CamDataPoint::CamDataPoint:  Constructor executed");
+    }
+
+    CamDataPoint::CamDataPoint(const std::string& name, std::uint16_t width, std::uint16_t height, CamImage image)
+        : SimIDataPoint(), _name(name), _width(width), _height(height), _image(image)
     {
         sim_logger->trace("CamDataPoint::CamDataPoint:  Constructor executed");
     }
@@ -36,6 +44,12 @@ namespace Nos3
     std::string CamDataPoint::to_string(void) const
     {
         sim_logger->info("CamDataPoint::to_string:  Executed");
-        return "A CamDataPoint";
+        if (!_image)
+        {
+            return "A CamDataPoint";
+        }
+        std::ostringstream oss;
+        oss << _name << " " << _width << "x" << _height << ", " << _image->size() << " bytes";
+        return oss.str();
     }
 }
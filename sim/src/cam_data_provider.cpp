@@ -21,6 +21,12 @@
 #include <ItcLogger/Logger.hpp>
 
 #include <boost/property_tree/xml_parser.hpp>
+#include <boost/algorithm/string.hpp>
+
+#include <algorithm>
+#include <dirent.h>
+#include <fstream>
+#include <iterator>
 
 namespace Nos3
 {
@@ -37,6 +43,16 @@ namespace Nos3
         //sim_logger->info("CamDataProvider::CamDataProvider:  "
         //    "configuration:\n%s", oss.str().c_str());
 
+        _cache_size = std::max(config.get("simulator.hardware-model.data-provider.cache-size", 8), 1);
+        _synthetic = config.get("simulator.hardware-model.data-provider.synthetic", false);
+        _synthetic_bytes = config.get("simulator.hardware-model.data-provider.synthetic-bytes", 0);
+        _synthetic_seed = config.get("simulator.hardware-model.data-provider.synthetic-seed", 1);
+        std::string directory = config.get("simulator.hardware-model.data-provider.image-directory", "");
+        if (!directory.empty())
+        {
+            index_directory(directory);
+        }
+
         sim_logger->trace("CamDataProvider::CamDataProvider:  Constructor exiting");
     }
 
@@ -49,8 +65,158 @@ namespace Nos3
     {
         sim_logger->info("CamDataProvider::get_data_point:  Executed");
 
+        // The frame last served, captures advance the sequence rather than polling
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_last)
+        {
+            return _last;
+        }
         CamDataPoint *msdp = new CamDataPoint();
         return boost::shared_ptr<SimIDataPoint>(msdp);
     }
+
+    boost::shared_ptr<CamDataPoint> CamDataProvider::next_frame(std::uint16_t width, std::uint16_t height)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Resolution key = (static_cast<Resolution>(width) << 16) | height;
+
+        auto files = _library.find(key);
+        if ((files == _library.end()) && _synthetic && (width > 0) && (height > 0))
+        {
+            size_t bytes = (_synthetic_bytes > 0) ? _synthetic_bytes : (static_cast<size_t>(width) * height) / 8;
+            _last.reset(new CamDataPoint("synthetic", width, height, _generator.get(width, height, bytes, _synthetic_seed)));
+            sim_logger->debug("CamDataProvider::next_frame:  %s", _last->to_string().c_str());
+            return _last;
+        }
+        if (files == _library.end())
+        {
+            sim_logger->debug("CamDataProvider::next_frame:  No frames for %ux%u", width, height);
+            return boost::shared_ptr<CamDataPoint>();
+        }
+
+        // Rotate through the frames of this resolution
+        size_t& next = _next[key];
+        const std::string& path = files->second[next];
+        next = (next + 1) % files->second.size();
+
+        CamImage image = load(path);
+        if (!image)
+        {
+            return boost::shared_ptr<CamDataPoint>();
+        }
+        _last.reset(new CamDataPoint(path, width, height, image));
+        sim_logger->debug("CamDataProvider::next_frame:  %s", _last->to_string().c_str());
+        return _last;
+    }
+
+    void CamDataProvider::index_directory(const std::string& directory)
+    {
+        std::uint16_t width, height;
+        std::vector<std::string> paths;
+
+        DIR *dir = opendir(directory.c_str());
+        if (dir == nullptr)
+        {
+            sim_logger->error("CamDataProvider::index_directory:  ERROR - could not read %s!", directory.c_str());
+            return;
+        }
+        for (struct dirent *entry = readdir(dir); entry != nullptr; entry = readdir(dir))
+        {
+            std::string name = entry->d_name;
+            std::string ext = boost::to_lower_copy(name.substr(std::min(name.rfind('.'), name.size())));
+            if ((ext == ".jpg") || (ext == ".jpeg") || (ext == ".bin"))
+            {
+                paths.push_back(directory + "/" + name);
+            }
+        }
+        closedir(dir);
+
+        // Name order makes the sequence of each resolution predictable
+        std::sort(paths.begin(), paths.end());
+        for (const std::string& path : paths)
+        {
+            if (jpeg_size(path, width, height))
+            {
+                _library[(static_cast<Resolution>(width) << 16) | height].push_back(path);
+            }
+            else
+            {
+                sim_logger->info("CamDataProvider::index_directory:  Skipping %s, no JPEG frame header", path.c_str());
+            }
+        }
+        for (const auto& entry : _library)
+        {
+            sim_logger->info("CamDataProvider::index_directory:  %ux%u, %zu frame(s)",
+                entry.first >> 16, entry.first & 0xFFFF, entry.second.size());
+        }
+    }
+
+    bool CamDataProvider::jpeg_size(const std::string& path, std::uint16_t& width, std::uint16_t& height)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::in);
+        std::uint8_t marker[4];
+        std::uint8_t sof[5];
+
+        // Must start with SOI
+        if (!file.read(reinterpret_cast<char*>(marker), 2) || (marker[0] != 0xFF) || (marker[1] != 0xD8))
+        {
+            return false;
+        }
+
+        // Walk the segments up to the frame header, only their lengths are read
+        while (file.read(reinterpret_cast<char*>(marker), 4))
+        {
+            if (marker[0] != 0xFF)
+            {
+                return false;
+            }
+            std::uint16_t length = (marker[2] << 8) | marker[3];
+            if ((marker[1] >= 0xC0) && (marker[1] <= 0xC3))
+            {
+                // SOF: precision, height, width
+                if (!file.read(reinterpret_cast<char*>(sof), sizeof(sof)))
+                {
+                    return false;
+                }
+                height = (sof[1] << 8) | sof[2];
+                width  = (sof[3] << 8) | sof[4];
+                return true;
+            }
+            if ((marker[1] == 0xDA) || (length < 2))
+            {
+                return false;
+            }
+            file.seekg(length - 2, std::ios::cur);
+        }
+        return false;
+    }
+
+    CamImage CamDataProvider::load(const std::string& path)
+    {
+        auto cached = _cache.find(path);
+        if (cached != _cache.end())
+        {
+            _lru.splice(_lru.begin(), _lru, cached->second.lru);
+            return cached->second.image;
+        }
+
+        std::ifstream file(path, std::ios::binary | std::ios::in);
+        if (!file)
+        {
+            sim_logger->error("CamDataProvider::load:  ERROR - could not open %s!", path.c_str());
+            return CamImage();
+        }
+        CamImage image(new std::vector<std::uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()));
+
+        // Make room, frames still being served stay alive through their shared pointer
+        while (_cache.size() >= _cache_size)
+        {
+            _cache.erase(_lru.back());
+            _lru.pop_back();
+        }
+        _lru.push_front(path);
+        _cache[path] = CacheEntry{image, _lru.begin()};
+        return image;
+    }
 }
 
@@ -21,7 +21,12 @@
 #include <ItcLogger/Logger.hpp>
 
 #include <boost/property_tree/xml_parser.hpp>
-#include <sys/stat.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <sstream>
 
 namespace Nos3
 {
@@ -29,7 +34,7 @@ namespace Nos3
 
     extern ItcLogger::Logger *sim_logger;
 
-    CamHardwareModel::CamHardwareModel(const boost::property_tree::ptree& config) : SimIHardwareModel(config), _keep_running(true)
+    CamHardwareModel::CamHardwareModel(const boost::property_tree::ptree& config) : SimIHardwareModel(config), _keep_running(true), _bus_waiters(0), _arduchip(config.get("simulator.hardware-model.arduchip-version", 0x40)), _fifo_pos(0), _sensor(sensor_type(config)), _burst_read(false), _capture_done(false), _frames_left(1), _timing(config), _capture_done_at(0.0), _spi_free_at(0.0), _i2c_free_at(0.0), _faults(0), _fault_until(0.0), _fault_expired(false)
     {
         sim_logger->trace("CamHardwareModel::CamHardwareModel:  Constructor executing");
 
@@ -42,36 +47,54 @@ namespace Nos3
         // Time node
         std::string connection_string = config.get("common.nos-connection-string", "tcp://127.0.0.1:12001");
 
-        std::string time_bus_name = "command";        
-        if (config.get_child_optional("hardware-model.connections")) 
+        // Buses default to the one camera on the flight computer, set them to run several
+        std::string time_bus_name = "command";
+        std::string i2c_bus_name = "i2c_2";
+        int i2c_bus_address = _sensor.i2c_address();
+        std::string spi_bus_name = "spi_0";
+        int chip_select = 0;
+        if (config.get_child_optional("simulator.hardware-model.connections"))
         {
-            BOOST_FOREACH(const boost::property_tree::ptree::value_type &v, config.get_child("hardware-model.connections")) 
+            BOOST_FOREACH(const boost::property_tree::ptree::value_type &v, config.get_child("simulator.hardware-model.connections"))
             {
-                if (v.second.get("type", "").compare("time") == 0) 
+                std::string type = v.second.get("type", "");
+                if (type.compare("time") == 0)
+                {
+                    time_bus_name = v.second.get("bus-name", time_bus_name);
+                }
+                else if (type.compare("i2c") == 0)
                 {
-                    time_bus_name = v.second.get("bus-name", "command");
-                    break;
+                    i2c_bus_name = v.second.get("bus-name", i2c_bus_name);
+                    i2c_bus_address = v.second.get("bus-address", i2c_bus_address);
+                }
+                else if (type.compare("spi") == 0)
+                {
+                    spi_bus_name = v.second.get("bus-name", spi_bus_name);
+                    chip_select = v.second.get("chip-select", chip_select);
                 }
             }
         }
         _time_bus.reset(new NosEngine::Client::Bus(_hub, connection_string, time_bus_name));
+        _time_bus->add_time_tick_callback(std::bind(&CamHardwareModel::time_tick, this, std::placeholders::_1));
 
-        // Initialize Register
-        memset(spi_register, 0, sizeof(spi_register));
+        // Image every capture puts in the FIFO
+        _default_image = load_image(config.get("simulator.hardware-model.image-file", "cam.bin"));
+        _image = _default_image;
 
         // Connect to Science I2C Bus
-        std::string i2c_bus_name = "i2c_2";
-        int i2c_bus_address = 60; // 0x3C
         _i2c_slave_connection = new I2CSlaveConnection(this, i2c_bus_address, connection_string, i2c_bus_name);
 
         // Connect to SPI Bus
-        std::string spi_bus_name = "spi_0";
-        int chip_select = 0;
         _spi_slave_connection = new SpiSlaveConnection(this, chip_select, connection_string, spi_bus_name);
 
+        sim_logger->info("CamHardwareModel::CamHardwareModel:  %s on %s address 0x%02x, %s chip select %d",
+            CamSensorModel::sensor_name(_sensor.sensor()), i2c_bus_name.c_str(), i2c_bus_address,
+            spi_bus_name.c_str(), chip_select);
+
         // Here's how to get a data provider
         std::string dp_name = config.get("simulator.hardware-model.data-provider.type", "CAMPROVIDER");
         _sdp = SimDataProviderFactory::Instance().Create(dp_name, config);
+        _cam_dp = dynamic_cast<CamDataProvider*>(_sdp);
 
         sim_logger->trace("CamHardwareModel::CamHardwareModel:  Time node, UART node, data provider created; constructor exiting");
     }
@@ -79,8 +102,8 @@ namespace Nos3
     CamHardwareModel::~CamHardwareModel(void)
     {
         sim_logger->trace("CamHardwareModel::CamHardwareModel:  Destructor executing");
-        delete _sdp; // Clean up the data provider we got
         _time_bus.reset(); // Must reset the time bus so the unique pointer does not try to delete the hub.  Do not destroy the time node, the bus will do it
+        delete _sdp; // Clean up the data provider we got
         
         // Clean up I2C
         delete _i2c_slave_connection;
@@ -89,157 +112,293 @@ namespace Nos3
         // Clean up SPI
         delete _spi_slave_connection;
         _spi_slave_connection = nullptr;
+    }
 
-        // Clean up File Pointer
-        if(fin.is_open())
+    CamSensorModel::Sensor CamHardwareModel::sensor_type(const boost::property_tree::ptree& config)
+    {
+        CamSensorModel::Sensor sensor = CamSensorModel::OV5640;
+        std::string name = config.get("simulator.hardware-model.sensor", "OV5640");
+
+        if (!CamSensorModel::parse(name, sensor))
         {
-            fin.close();
+            sim_logger->error("CamHardwareModel::sensor_type:  ERROR - unknown sensor %s, using OV5640!", name.c_str());
         }
+        return sensor;
     }
 
     void CamHardwareModel::run(void)
     {
-        int i = 0;
-        boost::shared_ptr<SimIDataPoint> dp;
-        while(_keep_running) 
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        // Sleeps until a command, a fault running out or shutdown, nothing is polled
+        while (_keep_running)
+        {
+            _wake.wait(lock, [this] {return !_keep_running || !_commands.empty() || _fault_expired;});
+
+            while (!_commands.empty() && _keep_running)
+            {
+                std::string command = _commands.front();
+                _commands.pop_front();
+                lock.unlock();
+                execute(command);
+                lock.lock();
+            }
+            if (_fault_expired)
+            {
+                _faults = 0;
+                _fault_expired = false;
+                sim_logger->info("CamHardwareModel::run:  Faults cleared at %f", _absolute_start_time +
+                    now_us() / 1000000.0);
+            }
+        }
+    }
+
+    void CamHardwareModel::time_tick(NosEngine::Common::SimTime time)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // Ticks only wake the run loop when a fault is due to clear
+        if ((_fault_until > 0.0) && ((double(time) * _sim_microseconds_per_tick) >= _fault_until))
         {
-            sim_logger->info("CamHardwareModel::run:  Loop count %d, time %f", i++,
-                _absolute_start_time + (double(_time_bus->get_time() * _sim_microseconds_per_tick)) / 1000000.0);
-            dp = _sdp->get_data_point();
-            sleep(5);
+            _fault_until = 0.0;
+            _fault_expired = true;
+            _wake.notify_one();
+        }
+
+        // Bus transfers waiting on sim time check how far it has got
+        if (_bus_waiters > 0)
+        {
+            _tick.notify_all();
         }
     }
 
-    std::uint8_t CamHardwareModel::determine_i2c_response_for_request(const std::vector<uint8_t>& in_data)
+    std::uint8_t CamHardwareModel::determine_i2c_response_for_request(const std::uint8_t *in_data, size_t len)
     {
         // Initialize local variables
         std::uint8_t out_data = 0x00;
 
-        // Which register?
-        switch (in_data[1])
-        {             
-            case 0x0A:
-                out_data = 0x56;
-                break;
-            
-            case 0x0B:
-                out_data = 0x40;
-                break;
+        // The sensor stops answering while an I2C fault is injected
+        if ((len < _sensor.address_bytes()) || (_faults & FAULT_I2C))
+        {
+            return out_data;
+        }
 
-            default:
-                break;
+        // Register address then values, sequential registers share one write
+        size_t address_bytes = _sensor.address_bytes();
+        std::uint16_t reg = (address_bytes == 2) ? ((in_data[0] << 8) | in_data[1]) : in_data[0];
+        for (size_t i = address_bytes; i < len; i++)
+        {
+            _sensor.write(reg + (i - address_bytes), in_data[i]);
         }
 
+        // A read that follows returns the register addressed
+        out_data = _sensor.read(reg);
+
         return out_data;
     }
 
-    std::uint16_t CamHardwareModel::determine_spi_response_for_request(const std::vector<uint8_t>& in_data)
+    std::uint16_t CamHardwareModel::determine_spi_response_for_request(const std::uint8_t *in_data, size_t len)
     {
         // Initialize local variables
-        std::uint16_t out_data = 0x0000;
         std::uint8_t reg = (in_data[0] & 0x7F);
-        struct stat st;
+        std::uint8_t value = (len > 1) ? in_data[1] : 0x00;
+        std::uint8_t out_data = 0x00;
+
+        // Any new command ends a burst read
+        _burst_read = false;
 
-        // Check write bit
-        if ((in_data[0] & 0x80) == 0x80)
+        // The FIFO ports do not decode the write bit
+        if ((reg == CamArduChipModel::BURST_FIFO_READ) || (reg == CamArduChipModel::FIFO_READ))
         {
-            // Process register
-            switch (reg)
-            {   
-                case 0x01: // Capture Control
-                    // Number of frames to be captures
-                    break;
-
-                case 0x02: // Start capture
-                    if(!fin.is_open())
-                    {
-                        fin.open("cam.bin", std::ios::binary | std::ios::in);
-                        sim_logger->debug("Opening cam.bin");
-                    }
-                    fin.clear();
-                    fin.seekg(0, std::ios::beg);
-                    // Determine file size
-                    if (stat("cam.bin", &st) != 0)
-                    {
-                        fifo_length = 0;
-                        sim_logger->error("CamHardwareModel::determine_spi_response_for_request: ERROR - get fifo length failure!");
-                    }
-                    else
-                    {
-                        fifo_length = st.st_size;
-                    };
-
-                    break;
-
-                case 0x03: // Sensor Interface Timing
-                    break;
-
-                case 0x04: // FIFO Control
-                    break;
-
-                case 0x05: // GPIO Direction
-                    break;
-                
-                case 0x06: // GPIO Write
-                    break;
-
-                default:
-                    break;
+            _arduchip.read(reg, out_data);
+            if (reg == CamArduChipModel::BURST_FIFO_READ)
+            {
+                // Following SPI reads clock out the FIFO until the next command
+                _burst_read = true;
+            }
+            else
+            {
+                fifo_next();
             }
-            spi_register[reg] = in_data[1];            
         }
-
-        // Set out data
-        switch (reg)
+        else if (in_data[0] & 0x80)
         {
-            case 0x3C:  // Burst FIFO Read
-                sim_logger->error("CamHardwareModel::determine_spi_response_for_request: ERROR - burst FIFO read not supported!");
-                break;
-
-            case 0x3D:  // Single FIFO Read
-                out_data = spi_register[reg] << 8;
-                if (!fin.eof())
+            if (_arduchip.write(reg, value) && (reg == CamArduChipModel::FIFO_CONTROL))
+            {
+                if (value & CamArduChipModel::FIFO_CLEAR_DONE)
                 {
-                    fin.read(reinterpret_cast<char*>(&spi_register[reg]), 1);
+                    _capture_done = false;
                 }
-                break;
+                if (value & (CamArduChipModel::FIFO_RESET_WRITE | CamArduChipModel::FIFO_RESET_READ))
+                {
+                    fifo_rewind();
+                }
+                if (value & CamArduChipModel::FIFO_START) // Done once the timing model says the FIFO is full
+                {
+                    start_capture();
+                    _capture_done = true;
+                }
+            }
+        }
+        else
+        {
+            if (reg == CamArduChipModel::STATUS)
+            {
+                _arduchip.set_capture_done(capture_done());
+            }
+            _arduchip.read(reg, out_data);
+        }
 
-            case 0x40:  // ArduChip Version
-                out_data = out_data | 0x4000; // 0x40 for 2MP Model
-                break;
+        // The register comes back in the second byte clocked out
+        return out_data << 8;
+    }
 
-            case 0x41:  // Capture Done Flag
-                out_data = out_data | 0x0800;
-                break;
+    bool CamHardwareModel::burst_read_active(void) const
+    {
+        return _burst_read;
+    }
 
-            // Reserved
-            case 0x3B:
-            case 0x3E:
-            case 0x3F:
-                sim_logger->error("ERROR - attempted access of reserved register!");
-                break;
+    void CamHardwareModel::read_fifo_burst(std::uint8_t *rbuf, size_t rlen)
+    {
+        // Same pipelining as single reads, the byte already fetched goes out first
+        for (size_t i = 0; i < rlen; i++)
+        {
+            rbuf[i] = _arduchip.fifo_data();
+            fifo_next();
+        }
+    }
 
-            case 0x42:  // Camera write FIFO size [7:0]
-                out_data = fifo_length >> 8;
-                break;
-            case 0x43:  // Camera write FIFO size [15:8]
-                out_data = fifo_length;
-                break;
-            case 0x44:  // Camera write FIFO size [18:16]
-                out_data = fifo_length << 8;
-                break;
+    void CamHardwareModel::spi_transfer(size_t bytes)
+    {
+        bus_wait(_spi_free_at, _timing.spi_us(bytes));
+    }
+
+    void CamHardwareModel::i2c_transfer(size_t bytes)
+    {
+        bus_wait(_i2c_free_at, _timing.i2c_us(bytes));
+    }
 
-            // TODO: Unimplemented
-            case 0x02:
-            
-            case 0x45:  // GPIO Read Register
+    double CamHardwareModel::now_us(void) const
+    {
+        return double(_time_bus->get_time()) * _sim_microseconds_per_tick;
+    }
+
+    void CamHardwareModel::bus_wait(double& free_at, double us)
+    {
+        if (us <= 0.0)
+        {
+            return;
+        }
 
-            default:
-                out_data = (spi_register[reg] << 8) | spi_register[reg];
+        // Transfers queue behind each other on the bus, their time is owed until it adds up to more than a tick
+        double now = now_us();
+        free_at = std::max(free_at, now) + us;
+        if ((free_at - now) <= _sim_microseconds_per_tick)
+        {
+            return;
+        }
+
+        // Sleep on the tick callback until the bus is less than a tick ahead, unless the clock has stopped
+        std::unique_lock<std::mutex> lock(_mutex);
+        _bus_waiters++;
+        while (_keep_running && ((free_at - now_us()) > _sim_microseconds_per_tick))
+        {
+            if (_tick.wait_for(lock, std::chrono::seconds(1)) == std::cv_status::timeout)
+            {
+                sim_logger->warning("CamHardwareModel::bus_wait: Sim time is not advancing, not waiting");
+                free_at = now_us();
                 break;
+            }
         }
+        _bus_waiters--;
+    }
 
-        return out_data;
+    bool CamHardwareModel::capture_done(void) const
+    {
+        return _capture_done && !(_faults & FAULT_CAPTURE) && (now_us() >= _capture_done_at);
+    }
+
+    CamImage CamHardwareModel::load_image(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::in);
+
+        if (!file)
+        {
+            sim_logger->error("CamHardwareModel::load_image: ERROR - could not open %s!", path.c_str());
+            return CamImage();
+        }
+        CamImage image(new std::vector<std::uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()));
+        sim_logger->info("CamHardwareModel::load_image: %s, %zu bytes", path.c_str(), image->size());
+        return image;
+    }
+
+    void CamHardwareModel::start_capture(void)
+    {
+        std::uint16_t width = _sensor.output_width();
+        std::uint16_t height = _sensor.output_height();
+        CamSensorModel::Format format = _sensor.output_format();
+        boost::shared_ptr<CamDataPoint> frame;
+
+        // Only JPEG images are served, anything else means the register tables are off
+        if (format != CamSensorModel::FORMAT_JPEG)
+        {
+            sim_logger->warning("CamHardwareModel::start_capture: Sensor programmed for %s output, serving JPEG",
+                CamSensorModel::format_name(format));
+        }
+        sim_logger->debug("CamHardwareModel::start_capture: %ux%u after %zu register writes to %zu registers, %zu redundant",
+            width, height, _sensor.writes(), _sensor.registers(), _sensor.redundant_writes());
+
+        // Next library frame at the configured resolution, otherwise the default image
+        if (_cam_dp != nullptr)
+        {
+            frame = _cam_dp->next_frame(width, height);
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        _image = frame ? frame->get_image() : _default_image;
+
+        // The FIFO holds the image once per frame requested in the capture control register
+        _frames_left = _arduchip.frames();
+        std::uint32_t length = 0;
+        _fifo_pos = 0;
+        if (!_image || _image->empty())
+        {
+            sim_logger->error("CamHardwareModel::start_capture: ERROR - no image loaded!");
+        }
+        else
+        {
+            length = _image->size() * _frames_left;
+        }
+        _arduchip.set_fifo_length(length);
+        _capture_done_at = now_us() + _timing.capture_us(width, height, length);
+        sim_logger->debug("CamHardwareModel::start_capture: %u frame(s), fifo length %u, done at %.0f us", _frames_left,
+            length, _capture_done_at);
+    }
+
+    void CamHardwareModel::fifo_next(void)
+    {
+        if (!_image)
+        {
+            return;
+        }
+        if ((_fifo_pos >= _image->size()) && (_frames_left > 1))
+        {
+            // Next frame starts right after the end of the last one
+            _frames_left--;
+            _fifo_pos = 0;
+        }
+        if (_fifo_pos < _image->size())
+        {
+            // A FIFO fault loses the second half of each frame, end of image included
+            bool lost = (_faults & FAULT_FIFO) && (_fifo_pos >= (_image->size() / 2));
+            _arduchip.set_fifo_data(lost ? 0x00 : (*_image)[_fifo_pos]);
+            _fifo_pos++;
+        }
+    }
+
+    void CamHardwareModel::fifo_rewind(void)
+    {
+        _frames_left = _arduchip.frames();
+        _fifo_pos = 0;
     }
 
     void CamHardwareModel::command_callback(NosEngine::Common::Message msg)
@@ -248,20 +407,93 @@ namespace Nos3
         NosEngine::Common::DataBufferOverlay dbf(const_cast<NosEngine::Utility::Buffer&>(msg.buffer));
         sim_logger->info("CamHardwareModel::command_callback:  Received command: %s.", dbf.data);
 
-        // Do something with the data
+        // Commands are checked here and carried out by the run loop, image paths keep their case
         std::string command = dbf.data;
-        std::string response = "CamHardwareModel::command_callback:  INVALID COMMAND! (Try STOP CAMSIM)";
-        boost::to_upper(command);
-        if (command.compare("STOP CAMSIM") == 0) 
+        std::string upper = boost::to_upper_copy(command);
+        std::string response = "CamHardwareModel::command_callback:  INVALID COMMAND! (Try STOP CAMSIM, "
+            "LOAD IMAGE <path>, SET EXPOSURE <us> or INJECT FAULT <I2C|CAPTURE|FIFO|NONE> [seconds])";
+        if (upper.compare("STOP CAMSIM") == 0)
         {
+            std::lock_guard<std::mutex> lock(_mutex);
             _keep_running = false;
+            _wake.notify_one();
             response = "CamHardwareModel::command_callback:  STOPPING CAMSIM";
         }
+        else if ((upper.compare(0, 11, "LOAD IMAGE ") == 0) || (upper.compare(0, 13, "SET EXPOSURE ") == 0) ||
+                 (upper.compare(0, 13, "INJECT FAULT ") == 0))
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _commands.push_back(command);
+            _wake.notify_one();
+            response = "CamHardwareModel::command_callback:  QUEUED " + command;
+        }
 
         // Here's how to send a reply
         _command_node->send_reply_message_async(msg, response.size(), response.c_str());
     }
 
+    void CamHardwareModel::execute(const std::string& command)
+    {
+        std::string upper = boost::to_upper_copy(command);
+        std::istringstream args(upper);
+        std::string verb, noun;
+
+        args >> verb >> noun;
+        if (upper.compare(0, 11, "LOAD IMAGE ") == 0)
+        {
+            CamImage image = load_image(boost::trim_copy(command.substr(11)));
+            if (image)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _default_image = image;
+            }
+        }
+        else if (upper.compare(0, 13, "SET EXPOSURE ") == 0)
+        {
+            double us = -1.0;
+            if (!(args >> us) || (us < 0.0))
+            {
+                sim_logger->error("CamHardwareModel::execute:  ERROR - bad exposure in %s!", command.c_str());
+                return;
+            }
+            std::lock_guard<std::mutex> lock(_mutex);
+            _timing.set_exposure_us(us);
+            sim_logger->info("CamHardwareModel::execute:  Exposure %.0f us at every resolution", us);
+        }
+        else if (upper.compare(0, 13, "INJECT FAULT ") == 0)
+        {
+            std::string fault;
+            double seconds = 0.0;
+            std::uint8_t faults = 0;
+
+            args >> fault >> seconds;
+            if (fault.compare("I2C") == 0)
+            {
+                faults = FAULT_I2C;
+            }
+            else if (fault.compare("CAPTURE") == 0)
+            {
+                faults = FAULT_CAPTURE;
+            }
+            else if (fault.compare("FIFO") == 0)
+            {
+                faults = FAULT_FIFO;
+            }
+            else if (fault.compare("NONE") != 0)
+            {
+                sim_logger->error("CamHardwareModel::execute:  ERROR - unknown fault in %s!", command.c_str());
+                return;
+            }
+
+            // Faults add up until NONE, a duration clears them all once it passes
+            std::lock_guard<std::mutex> lock(_mutex);
+            _faults = (faults == 0) ? 0 : (_faults | faults);
+            _fault_until = ((faults != 0) && (seconds > 0.0)) ? now_us() + (seconds * 1000000.0) : 0.0;
+            sim_logger->info("CamHardwareModel::execute:  Faults 0x%02x%s", _faults.load(),
+                (_fault_until > 0.0) ? ", clearing on a timer" : "");
+        }
+    }
+
     I2CSlaveConnection::I2CSlaveConnection(CamHardwareModel* hm,
         int bus_address, std::string connection_string, std::string bus_name)
         : NosEngine::I2C::I2CSlave(bus_address, connection_string, bus_name)
@@ -273,6 +505,7 @@ namespace Nos3
     {
         size_t num_read;
         sim_logger->debug("i2c_read: 0x%02x", _i2c_out_data); // log data
+        _hardware_model->i2c_transfer(rlen + 1);
         if(rlen <= 1)
         {
             rbuf[0] = _i2c_out_data;
@@ -283,10 +516,11 @@ namespace Nos3
 
     size_t I2CSlaveConnection::i2c_write(const uint8_t *wbuf, size_t wlen)
     {
-        std::vector<uint8_t> in_data(wbuf, wbuf + wlen);
-        sim_logger->debug("i2c_write: %s",
-            SimIHardwareModel::uint8_vector_to_hex_string(in_data).c_str()); // log data
-        _i2c_out_data = _hardware_model->determine_i2c_response_for_request(in_data);
+        // The logger only formats when debug is enabled, so pass values rather than build a string
+        sim_logger->debug("i2c_write: %zu bytes, 0x%02x 0x%02x 0x%02x", wlen, (wlen > 0) ? wbuf[0] : 0,
+            (wlen > 1) ? wbuf[1] : 0, (wlen > 2) ? wbuf[2] : 0); // log data
+        _hardware_model->i2c_transfer(wlen + 1); // Device address goes first
+        _i2c_out_data = _hardware_model->determine_i2c_response_for_request(wbuf, wlen);
         return wlen;
     }
 
@@ -302,7 +536,12 @@ namespace Nos3
         sim_logger->debug("spi_read: 0x%04x", _spi_out_data); // log data
         //sim_logger->debug("spi_read: rlen = 0x%02x", rlen);
         
-        if(rlen <= 2)
+        _hardware_model->spi_transfer(rlen);
+        if(_hardware_model->burst_read_active())
+        {
+            _hardware_model->read_fifo_burst(rbuf, rlen);
+        }
+        else if(rlen <= 2)
         {
             rbuf[0] = (_spi_out_data & 0x00FF);
             rbuf[1] = (_spi_out_data & 0xFF00) >> 8;
@@ -315,10 +554,14 @@ namespace Nos3
 
     size_t SpiSlaveConnection::spi_write(const uint8_t *wbuf, size_t wlen)
     {
-        std::vector<uint8_t> in_data(wbuf, wbuf + wlen);
-        sim_logger->debug("spi_write: %s",
-            SimIHardwareModel::uint8_vector_to_hex_string(in_data).c_str()); // log data
-        _spi_out_data = _hardware_model->determine_spi_response_for_request(in_data);
+        if (wlen == 0)
+        {
+            return wlen;
+        }
+        // The logger only formats when debug is enabled, so pass values rather than build a string
+        sim_logger->debug("spi_write: 0x%02x 0x%02x", wbuf[0], (wlen > 1) ? wbuf[1] : 0); // log data
+        _hardware_model->spi_transfer(wlen);
+        _spi_out_data = _hardware_model->determine_spi_response_for_request(wbuf, wlen);
         return wlen;
     }
 }
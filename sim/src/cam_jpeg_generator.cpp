@@ -0,0 +1,170 @@
+/* Copyright (C) 2016 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#include <cam_jpeg_generator.hpp>
+
+#include <ItcLogger/Logger.hpp>
+
+#include <random>
+
+namespace Nos3
+{
+    extern ItcLogger::Logger *sim_logger;
+
+    namespace
+    {
+        // Each coefficient is AC symbol 0x0A (run 0, size 10): code "10" then 10 value bits
+        const unsigned COEF_BITS = 12;
+
+        // DC differences are always 0 and AC blocks end with EOB, both coded "0"
+        const unsigned BLOCK_BITS = 2;
+
+        class BitWriter
+        {
+        public:
+            BitWriter(std::vector<std::uint8_t>& out) : _out(out), _acc(0), _count(0) {}
+            void put(std::uint32_t bits, unsigned n)
+            {
+                while (n-- > 0)
+                {
+                    _acc = (_acc << 1) | ((bits >> n) & 1);
+                    if (++_count == 8)
+                    {
+                        emit();
+                    }
+                }
+            }
+            void flush(void)
+            {
+                // Pad the last byte with ones
+                while (_count != 0)
+                {
+                    put(1, 1);
+                }
+            }
+        private:
+            void emit(void)
+            {
+                _out.push_back(_acc);
+                if (_acc == 0xFF)
+                {
+                    _out.push_back(0x00); // Byte stuffing
+                }
+                _acc = 0;
+                _count = 0;
+            }
+            std::vector<std::uint8_t>& _out;
+            std::uint8_t               _acc;
+            unsigned                   _count;
+        };
+
+        void put_marker(std::vector<std::uint8_t>& out, std::uint8_t marker, std::uint16_t length)
+        {
+            out.push_back(0xFF);
+            out.push_back(marker);
+            out.push_back(length >> 8);
+            out.push_back(length & 0xFF);
+        }
+    }
+
+    CamImage CamJpegGenerator::get(std::uint16_t width, std::uint16_t height, size_t target_bytes, std::uint32_t seed)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Key key(width, height, target_bytes, seed);
+
+        auto cached = _cache.find(key);
+        if (cached != _cache.end())
+        {
+            return cached->second;
+        }
+        CamImage image = generate(width, height, target_bytes, seed);
+        _cache[key] = image;
+        return image;
+    }
+
+    CamImage CamJpegGenerator::generate(std::uint16_t width, std::uint16_t height, size_t target_bytes, std::uint32_t seed)
+    {
+        std::vector<std::uint8_t>* jpeg = new std::vector<std::uint8_t>();
+        std::vector<std::uint8_t> scan;
+        std::mt19937 rng(seed);
+        size_t blocks = ((width + 7) / 8) * ((height + 7) / 8);
+
+        // Headers: SOI, DQT, SOF0, DHT, SOS
+        std::vector<std::uint8_t> head = {0xFF, 0xD8};
+        put_marker(head, 0xDB, 67);
+        head.push_back(0x00);
+        head.insert(head.end(), 64, 0x01);
+        put_marker(head, 0xC0, 11);
+        head.insert(head.end(), {0x08, std::uint8_t(height >> 8), std::uint8_t(height), std::uint8_t(width >> 8), std::uint8_t(width), 0x01, 0x01, 0x11, 0x00});
+        put_marker(head, 0xC4, 2 + 17 + 1 + 17 + 2);
+        head.insert(head.end(), {0x00, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x00});
+        head.insert(head.end(), {0x10, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x00, 0x0A});
+        std::vector<std::uint8_t> sos;
+        put_marker(sos, 0xDA, 8);
+        sos.insert(sos.end(), {0x01, 0x01, 0x00, 0x00, 0x3F, 0x00});
+
+        // Spread the scan budget over the blocks, stuffing runs a little over so aim just under
+        size_t fixed = head.size() + sos.size() + 2;
+        double budget = (target_bytes > fixed) ? (target_bytes - fixed) * 8.0 * 0.995 : 0.0;
+        double used = 0.0;
+        scan.reserve(target_bytes);
+        BitWriter bits(scan);
+        for (size_t b = 0; b < blocks; b++)
+        {
+            double want = budget * (b + 1) / blocks - used - BLOCK_BITS;
+            unsigned coefs = (want > 0.0) ? std::min<unsigned>(63, unsigned(want / COEF_BITS)) : 0;
+
+            bits.put(0, 1); // DC difference 0
+            for (unsigned c = 0; c < coefs; c++)
+            {
+                bits.put((0x2u << 10) | (rng() & 0x3FF), COEF_BITS);
+            }
+            if (coefs < 63)
+            {
+                bits.put(0, 1); // EOB
+            }
+            used += BLOCK_BITS + coefs * COEF_BITS;
+        }
+        bits.flush();
+
+        // Comment segments make up the rest, their bytes never look like a marker
+        *jpeg = head;
+        size_t pad = (target_bytes > fixed + scan.size()) ? target_bytes - fixed - scan.size() : 0;
+        while (pad >= 4)
+        {
+            size_t length = std::min<size_t>(pad - 2, 0xFFFF);
+            if ((pad - 2 - length) > 0 && (pad - 2 - length) < 4)
+            {
+                length -= 4; // Leave enough for one more segment
+            }
+            put_marker(*jpeg, 0xFE, std::uint16_t(length));
+            for (size_t i = 2; i < length; i++)
+            {
+                jpeg->push_back(rng() & 0x7F);
+            }
+            pad -= length + 2;
+        }
+        jpeg->insert(jpeg->end(), sos.begin(), sos.end());
+        jpeg->insert(jpeg->end(), scan.begin(), scan.end());
+        jpeg->push_back(0xFF);
+        jpeg->push_back(0xD9);
+
+        sim_logger->debug("CamJpegGenerator::generate:  %ux%u seed %u, %zu bytes for %zu requested", width, height,
+            seed, jpeg->size(), target_bytes);
+        return CamImage(jpeg);
+    }
+}
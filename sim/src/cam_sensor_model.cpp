@@ -0,0 +1,233 @@
+/* Copyright (C) 2016 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#include <cam_sensor_model.hpp>
+
+#include <ItcLogger/Logger.hpp>
+
+#include <boost/algorithm/string.hpp>
+
+namespace Nos3
+{
+    extern ItcLogger::Logger *sim_logger;
+
+    namespace
+    {
+        // OV5640 and OV5642
+        const std::uint16_t CHIP_ID_HIGH  = 0x300A;
+        const std::uint16_t CHIP_ID_LOW   = 0x300B;
+        const std::uint16_t SYSTEM_CTRL   = 0x3008; // Bit 7 software reset
+        const std::uint16_t OUTPUT_WIDTH  = 0x3808; // Width [11:8], [7:0] then height the same
+        const std::uint16_t TIMING_TC_21  = 0x3821; // OV5640 bit 5 JPEG enable
+        const std::uint16_t TIMING_TC_18  = 0x3818; // OV5642 bit 3 JPEG enable
+        const std::uint16_t FORMAT_MUX    = 0x501F; // ISP output [2:0]
+
+        // OV2640, bank in the high byte
+        const std::uint16_t BANK_SELECT   = 0xFF;
+        const std::uint16_t OV2640_PID    = 0x10A;
+        const std::uint16_t OV2640_VER    = 0x10B;
+        const std::uint16_t OV2640_COM7   = 0x112; // Bit 7 software reset
+        const std::uint16_t OV2640_ZMOW   = 0x05A; // Output width / 4 [7:0]
+        const std::uint16_t OV2640_ZMOH   = 0x05B; // Output height / 4 [7:0]
+        const std::uint16_t OV2640_ZMHH   = 0x05C; // Width [9:8] in [1:0], height [8] in [2]
+        const std::uint16_t OV2640_IMAGE  = 0x0DA; // Image mode, bit 4 JPEG
+    }
+
+    CamSensorModel::CamSensorModel(Sensor sensor) : _sensor(sensor)
+    {
+        reset();
+    }
+
+    bool CamSensorModel::parse(const std::string& name, Sensor& sensor)
+    {
+        std::string upper = boost::to_upper_copy(name);
+        for (Sensor candidate : {OV2640, OV5640, OV5642})
+        {
+            if (upper == sensor_name(candidate))
+            {
+                sensor = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const char* CamSensorModel::sensor_name(Sensor sensor)
+    {
+        switch (sensor)
+        {
+            case OV2640:
+                return "OV2640";
+            case OV5642:
+                return "OV5642";
+            default:
+                return "OV5640";
+        }
+    }
+
+    void CamSensorModel::reset(void)
+    {
+        _bank = 0;
+        _registers.clear();
+        _writes = 0;
+        _redundant = 0;
+    }
+
+    std::uint16_t CamSensorModel::key(std::uint16_t reg) const
+    {
+        return (_sensor == OV2640) ? ((_bank << 8) | (reg & 0xFF)) : reg;
+    }
+
+    std::uint8_t CamSensorModel::stored(std::uint16_t index) const
+    {
+        auto entry = _registers.find(index);
+        return (entry != _registers.end()) ? entry->second : 0x00;
+    }
+
+    bool CamSensorModel::chip_id(std::uint16_t reg, std::uint8_t& value) const
+    {
+        switch (_sensor)
+        {
+            case OV2640:
+                value = (key(reg) == OV2640_PID) ? 0x26 : 0x42;
+                return (key(reg) == OV2640_PID) || (key(reg) == OV2640_VER);
+            case OV5642:
+                value = (reg == CHIP_ID_HIGH) ? 0x56 : 0x42;
+                break;
+            default:
+                value = (reg == CHIP_ID_HIGH) ? 0x56 : 0x40;
+                break;
+        }
+        return (reg == CHIP_ID_HIGH) || (reg == CHIP_ID_LOW);
+    }
+
+    std::uint8_t CamSensorModel::read(std::uint16_t reg) const
+    {
+        std::uint8_t value;
+
+        if (chip_id(reg, value))
+        {
+            return value;
+        }
+        if ((_sensor == OV2640) && (reg == BANK_SELECT))
+        {
+            return _bank;
+        }
+        return stored(key(reg));
+    }
+
+    void CamSensorModel::write(std::uint16_t reg, std::uint8_t value)
+    {
+        std::uint8_t id;
+
+        if (chip_id(reg, id))
+        {
+            sim_logger->debug("CamSensorModel::write:  Ignoring write of 0x%02x to read only register 0x%04x", value, reg);
+            return;
+        }
+        if (((_sensor == OV2640) && (key(reg) == OV2640_COM7) && (value & 0x80)) ||
+            ((_sensor != OV2640) && (reg == SYSTEM_CTRL) && (value & 0x80)))
+        {
+            sim_logger->debug("CamSensorModel::write:  Software reset after %zu writes", _writes);
+            reset();
+            return;
+        }
+
+        _writes++;
+        if ((_sensor == OV2640) && (reg == BANK_SELECT))
+        {
+            _bank = value & 0x01;
+            return;
+        }
+        auto entry = _registers.find(key(reg));
+        if (entry == _registers.end())
+        {
+            _registers.emplace(key(reg), value);
+        }
+        else
+        {
+            if (entry->second == value)
+            {
+                _redundant++;
+            }
+            entry->second = value;
+        }
+    }
+
+    std::uint16_t CamSensorModel::output_width(void) const
+    {
+        if (_sensor == OV2640)
+        {
+            return (((stored(OV2640_ZMHH) & 0x03) << 8) | stored(OV2640_ZMOW)) * 4;
+        }
+        return ((stored(OUTPUT_WIDTH) & 0x0F) << 8) | stored(OUTPUT_WIDTH + 1);
+    }
+
+    std::uint16_t CamSensorModel::output_height(void) const
+    {
+        if (_sensor == OV2640)
+        {
+            return ((((stored(OV2640_ZMHH) >> 2) & 0x01) << 8) | stored(OV2640_ZMOH)) * 4;
+        }
+        return ((stored(OUTPUT_WIDTH + 2) & 0x07) << 8) | stored(OUTPUT_WIDTH + 3);
+    }
+
+    CamSensorModel::Format CamSensorModel::output_format(void) const
+    {
+        switch (_sensor)
+        {
+            case OV2640:
+                return (stored(OV2640_IMAGE) & 0x10) ? FORMAT_JPEG : FORMAT_YUV;
+            case OV5642:
+                if (stored(TIMING_TC_18) & 0x08)
+                {
+                    return FORMAT_JPEG;
+                }
+                break;
+            default:
+                if (stored(TIMING_TC_21) & 0x20)
+                {
+                    return FORMAT_JPEG;
+                }
+                break;
+        }
+        switch (stored(FORMAT_MUX) & 0x07)
+        {
+            case 0x00:
+                return FORMAT_YUV;
+            case 0x01:
+                return FORMAT_RGB;
+            default:
+                return FORMAT_RAW;
+        }
+    }
+
+    const char* CamSensorModel::format_name(Format format)
+    {
+        switch (format)
+        {
+            case FORMAT_JPEG:
+                return "JPEG";
+            case FORMAT_YUV:
+                return "YUV";
+            case FORMAT_RGB:
+                return "RGB";
+            default:
+                return "RAW";
+        }
+    }
+}
@@ -0,0 +1,84 @@
+/* Copyright (C) 2016 - 2016 National Aeronautics and Space Administration. All Foreign Rights are Reserved to the U.S. Government.
+
+   This software is provided "as is" without any warranty of any, kind either express, implied, or statutory, including, but not
+   limited to, any warranty that the software will conform to, specifications any implied warranties of merchantability, fitness
+   for a particular purpose, and freedom from infringement, and any warranty that the documentation will conform to the program, or
+   any warranty that the software will be error free.
+
+   In no event shall NASA be liable for any damages, including, but not limited to direct, indirect, special or consequential damages,
+   arising out of, resulting from, or in any way connected with the software or its documentation.  Whether or not based upon warranty,
+   contract, tort or otherwise, and whether or not loss was sustained from, or arose out of the results of, or use of, the software,
+   documentation or services provided hereunder
+
+   ITC Team
+   NASA IV&V
+   ivv-itc@lists.nasa.gov
+*/
+
+#include <cam_timing_model.hpp>
+
+#include <ItcLogger/Logger.hpp>
+
+#include <boost/foreach.hpp>
+
+namespace Nos3
+{
+    extern ItcLogger::Logger *sim_logger;
+
+    CamTimingModel::CamTimingModel(const boost::property_tree::ptree& config)
+    {
+        _enabled        = config.get("simulator.hardware-model.timing.enabled", false);
+        _exposure_us    = config.get("simulator.hardware-model.timing.exposure-us", 100000.0);
+        _fifo_fill_rate = config.get("simulator.hardware-model.timing.fifo-fill-bytes-per-sec", 4000000.0);
+        _spi_clock      = config.get("simulator.hardware-model.timing.spi-clock-hz", 1000000.0);
+        _i2c_byte_us    = config.get("simulator.hardware-model.timing.i2c-byte-us", 90.0);
+
+        if (config.get_child_optional("simulator.hardware-model.timing.exposures"))
+        {
+            BOOST_FOREACH(const boost::property_tree::ptree::value_type &v, config.get_child("simulator.hardware-model.timing.exposures"))
+            {
+                std::uint32_t width = v.second.get("width", 0);
+                std::uint32_t height = v.second.get("height", 0);
+                _exposures_us[(width << 16) | height] = v.second.get("us", _exposure_us);
+            }
+        }
+
+        if (_enabled)
+        {
+            sim_logger->info("CamTimingModel::CamTimingModel:  Exposure %.0f us (%zu resolution(s) set), "
+                "FIFO fill %.0f B/s, SPI %.0f Hz, I2C %.1f us/byte", _exposure_us, _exposures_us.size(),
+                _fifo_fill_rate, _spi_clock, _i2c_byte_us);
+        }
+    }
+
+    void CamTimingModel::set_exposure_us(double us)
+    {
+        _exposure_us = us;
+        _exposures_us.clear();
+    }
+
+    double CamTimingModel::capture_us(std::uint16_t width, std::uint16_t height, size_t bytes) const
+    {
+        if (!_enabled)
+        {
+            return 0.0;
+        }
+        auto exposure = _exposures_us.find((static_cast<std::uint32_t>(width) << 16) | height);
+        double us = (exposure != _exposures_us.end()) ? exposure->second : _exposure_us;
+        if (_fifo_fill_rate > 0.0)
+        {
+            us += bytes * 1000000.0 / _fifo_fill_rate;
+        }
+        return us;
+    }
+
+    double CamTimingModel::spi_us(size_t bytes) const
+    {
+        return (_enabled && (_spi_clock > 0.0)) ? (bytes * 8 * 1000000.0 / _spi_clock) : 0.0;
+    }
+
+    double CamTimingModel::i2c_us(size_t bytes) const
+    {
+        return _enabled ? (bytes * _i2c_byte_us) : 0.0;
+    }
+}